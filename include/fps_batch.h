@@ -0,0 +1,76 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#pragma once
+#ifndef fps_batch_h
+#define fps_batch_h
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <fps_slab.h>
+#include <fpsutil_export.h>
+
+// One element of a batched tick: count frames for the channel behind a handle or a key.
+struct FpsTick {
+  FpsHandle handle;
+  uint64_t  count{1};
+};
+
+struct FpsKeyTick {
+  FpsKey   key;
+  uint64_t count{1};
+};
+
+// Coalesces the ticks of one producer thread per channel, so a stage handling batches of frames pays one counter
+// update per channel per sampling pass instead of one per frame. Slots are direct mapped on the channel's slab index;
+// a collision applies the previous channel's count first. Only the owner thread adds; the monitor flushes before
+// every sampling pass, so the mutex is practically never contended.
+class FPSUTIL_EXPORT FpsTickBuffer {
+private:
+  static constexpr size_t SLOTS = 64;
+
+  struct Slot {
+    FpsStatus* status{nullptr};
+    uint32_t   generation{0};
+    uint64_t   count{0};
+  };
+
+  std::mutex              mtx_;
+  std::array<Slot, SLOTS> slots_{};
+
+  static void apply_(Slot& slot);
+
+public:
+  // Ticks for channels that were unregistered are dropped; returns how many elements were accepted.
+  size_t add(const FpsTick* ticks, size_t count);
+  void   flush();
+};
+
+// The per-thread buffers of one monitor. Each thread gets its buffer on first use; buffers of threads that have
+// exited are flushed once more and released on the next flush. A thread keeps the buffers of the last few monitors it
+// ticked through, so one that cycles through more of them replaces a buffer on every switch and batching stops paying
+// off; evictions() counts those replacements.
+class FPSUTIL_EXPORT FpsTickBuffers {
+private:
+  const uint64_t                              serial_;
+  std::mutex                                  mtx_;
+  std::vector<std::shared_ptr<FpsTickBuffer>> buffers_;
+  std::atomic_uint64_t                        evictions_{0};
+
+public:
+  FpsTickBuffers();
+
+  FpsTickBuffer& local();
+  void           flush();
+  // Buffers of other monitors this one's threads had to evict to get their own.
+  uint64_t       evictions() const { return evictions_.load(std::memory_order_relaxed); }
+};
+
+#endif // fps_batch_h
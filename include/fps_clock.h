@@ -0,0 +1,84 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#pragma once
+#ifndef fps_clock_h
+#define fps_clock_h
+
+#include <atomic>
+#include <cstdint>
+
+#include <fpsutil_export.h>
+
+// Time source for every rate computation. now_ns() is monotonic, so wall clock steps never show up as negative or
+// huge intervals; wall_ms() is only used to label log lines and snapshots.
+class FPSUTIL_EXPORT FpsClock {
+public:
+  static constexpr int64_t NS_IN_MS = 1000000;
+
+  FpsClock()                           = default;
+  virtual ~FpsClock()                  = default;
+  FpsClock(const FpsClock&)            = delete;
+  FpsClock& operator=(const FpsClock&) = delete;
+  FpsClock(FpsClock&&)                 = delete;
+  FpsClock& operator=(FpsClock&&)      = delete;
+
+  virtual int64_t now_ns() const = 0;
+  virtual int64_t wall_ms() const;
+  int64_t         now_ms() const { return now_ns() / NS_IN_MS; }
+
+  // std::chrono::steady_clock; the default everywhere.
+  static const FpsClock& steady();
+  // Clock read on every tick of a timed channel (see FpsJitter). nullptr restores steady(); the clock must outlive
+  // every tick that may still use it.
+  static const FpsClock& tick_clock() { return *tick_clock_.load(std::memory_order_acquire); }
+  static void            set_tick_clock(const FpsClock* clock);
+
+private:
+  static std::atomic<const FpsClock*> tick_clock_;
+};
+
+class FPSUTIL_EXPORT FpsSteadyClock : public FpsClock {
+public:
+  int64_t now_ns() const override;
+};
+
+// CLOCK_MONOTONIC_COARSE where available: a few nanoseconds per read at scheduler-tick resolution (1-4 ms), which is
+// plenty for frame gaps. Falls back to steady_clock elsewhere.
+class FPSUTIL_EXPORT FpsCoarseClock : public FpsClock {
+public:
+  int64_t now_ns() const override;
+};
+
+// Time stamp counter scaled by a factor calibrated against steady_clock at construction. Needs an invariant TSC, as
+// reported by CPUID; falls back to steady_clock where the bit is clear and on other architectures.
+class FPSUTIL_EXPORT FpsTscClock : public FpsClock {
+private:
+  uint64_t base_ticks_{0};
+  int64_t  base_ns_{0};
+  double   ns_per_tick_{1.0};
+
+public:
+  FpsTscClock();
+  int64_t     now_ns() const override;
+  static bool is_supported();
+};
+
+// Manually driven clock for deterministic tests and replays; starts at zero.
+class FPSUTIL_EXPORT FpsVirtualClock : public FpsClock {
+private:
+  std::atomic_int64_t now_ns_{0};
+  std::atomic_int64_t epoch_ms_{0};
+
+public:
+  explicit FpsVirtualClock(int64_t epoch_ms = 0) : epoch_ms_(epoch_ms) {}
+  int64_t now_ns() const override { return now_ns_.load(std::memory_order_acquire); }
+  // Wall time is epoch_ms plus the virtual time elapsed.
+  int64_t wall_ms() const override { return epoch_ms_.load(std::memory_order_relaxed) + now_ms(); }
+  void    set_ns(int64_t now_ns) { now_ns_.store(now_ns, std::memory_order_release); }
+  void    advance_ns(int64_t ns) { now_ns_.fetch_add(ns, std::memory_order_acq_rel); }
+  void    advance_ms(int64_t ms) { advance_ns(ms * NS_IN_MS); }
+};
+
+#endif // fps_clock_h
@@ -7,19 +7,220 @@
 #define fps_counter_h
 
 #include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <fps_clock.h>
+#include <fps_estimator.h>
+#include <fps_slab.h>
 #include <fpsutil_export.h>
+#include <memory>
 
-class FPSUTIL_EXPORT FpsCounter {
+// State published when a window closes: the count and time at the close and the rate over the window.
+struct FpsCounterReading {
+  uint64_t count{0};
+  int64_t  ts{0};
+  float    fps{0.0};
+};
+
+// ---- Window policy ----
+
+template <int64_t Ms> struct FpsWindow {
+  static_assert(Ms > 0, "the window must be positive");
+  static constexpr int64_t MS = Ms;
+};
+
+// ---- Clock policies: now_ms() in milliseconds on a monotonic clock ----
+
+// Any FpsClock chosen at construction (steady by default); one virtual call per read.
+class FpsClockRef {
 private:
-  int64_t                   last_write_ts_{0};
-  std::atomic_uint_fast64_t value_{0};
-  std::atomic_uint_fast64_t last_value_{0};
-  std::atomic<float>        last_fps_{0.0};
-  void                      calculate_fps_(int64_t ts);
+  const FpsClock* clock_{&FpsClock::steady()};
 
 public:
-  std::atomic_uint_fast64_t& set_status(int64_t value = 1);
-  float                      get_fps(int64_t ts = -1);
+  FpsClockRef() = default;
+  FpsClockRef(const FpsClock& clock) : clock_(&clock) {} // NOLINT(google-explicit-constructor)
+  int64_t now_ms() const { return clock_->now_ms(); }
+};
+
+// A std::chrono clock read inline, for counters that never need an injected clock.
+template <class Clock = std::chrono::steady_clock> struct FpsChronoClock {
+  static_assert(Clock::is_steady, "rates need a monotonic clock");
+  int64_t now_ms() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now().time_since_epoch()).count();
+  }
+};
+
+// ---- Concurrency policies ----
+// Each provides the count type with add/load, and a State holding the published reading: read() for readers,
+// lock()/try_lock()/unlock() to serialise window closes, and publish() called under that lock.
+
+// Everything on one thread; no atomics at all.
+struct FpsSingleThreaded {
+  using count_type = uint64_t;
+  static void     add(count_type& count, uint64_t value) { count += value; }
+  static uint64_t load(const count_type& count) { return count; }
+
+  class State {
+  private:
+    FpsCounterReading reading_;
+
+  public:
+    FpsCounterReading read() const { return reading_; }
+    void              lock() {}
+    bool              try_lock() { return true; }
+    void              unlock() {}
+    void              publish(const FpsCounterReading& reading) { reading_ = reading; }
+  };
 };
+
+// Any number of threads count; get_fps(), get_stats() and reading() stay on one sampling thread.
+struct FpsMultiWriter {
+  using count_type = std::atomic_uint_fast64_t;
+  static void     add(count_type& count, uint64_t value) { count.fetch_add(value, std::memory_order_relaxed); }
+  static uint64_t load(const count_type& count) { return count.load(std::memory_order_relaxed); }
+
+  using State = FpsSingleThreaded::State;
+};
+
+// Any number of threads count and read. Window closes are serialised by a spin flag and published through a seqlock,
+// so readers never block the closer and always get a consistent (count, ts, fps) triple.
+struct FpsSeqlock {
+  using count_type = std::atomic_uint_fast64_t;
+  static void     add(count_type& count, uint64_t value) { count.fetch_add(value, std::memory_order_relaxed); }
+  static uint64_t load(const count_type& count) { return count.load(std::memory_order_relaxed); }
+
+  class State {
+  private:
+    std::atomic_uint32_t sequence_{0};
+    std::atomic_uint64_t count_{0};
+    std::atomic_int64_t  ts_{0};
+    std::atomic<float>   fps_{0.0};
+    std::atomic_flag     writer_ = ATOMIC_FLAG_INIT;
+
+  public:
+    FpsCounterReading read() const {
+      FpsCounterReading reading;
+      uint32_t          before = 0;
+      do {
+        before = sequence_.load(std::memory_order_acquire);
+        while ((before & 1U) != 0) {
+          before = sequence_.load(std::memory_order_acquire);
+        }
+        reading.count = count_.load(std::memory_order_relaxed);
+        reading.ts    = ts_.load(std::memory_order_relaxed);
+        reading.fps   = fps_.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+      } while (sequence_.load(std::memory_order_relaxed) != before);
+      return reading;
+    }
+    void lock() {
+      while (writer_.test_and_set(std::memory_order_acquire)) {
+      }
+    }
+    bool try_lock() { return !writer_.test_and_set(std::memory_order_acquire); }
+    void unlock() { writer_.clear(std::memory_order_release); }
+    void publish(const FpsCounterReading& reading) {
+      const uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+      sequence_.store(sequence + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      count_.store(reading.count, std::memory_order_relaxed);
+      ts_.store(reading.ts, std::memory_order_relaxed);
+      fps_.store(reading.fps, std::memory_order_relaxed);
+      sequence_.store(sequence + 2, std::memory_order_release);
+    }
+  };
+};
+
+// Counts events and turns them into a rate once per Window. Timestamps passed to get_fps_at() and get_stats_at() are
+// milliseconds on the Clock, which is monotonic: wall clock epoch milliseconds give stale or negative intervals.
+template <class Window = FpsWindow<10000>, class Clock = FpsClockRef, class Concurrency = FpsSeqlock>
+class FpsBasicCounter {
+private:
+  using count_type = typename Concurrency::count_type;
+  using State      = typename Concurrency::State;
+
+  static constexpr float MILLI_SECONDS_IN_SECOND = 1000.0F;
+
+  alignas(FPS_CACHE_LINE_SIZE) count_type value_{0};
+  alignas(FPS_CACHE_LINE_SIZE) State state_;
+  std::unique_ptr<FpsRateEstimator> estimator_;
+  Clock                             clock_;
+
+  int64_t now_(int64_t ts) const { return ts >= 0 ? ts : clock_.now_ms(); }
+
+  // Called with the state locked.
+  void close_window_(int64_t ts) {
+    const FpsCounterReading last      = state_.read();
+    const int64_t           time_diff = ts - last.ts;
+    if (time_diff < Window::MS) {
+      return;
+    }
+    const uint64_t count = total();
+    const float    fps =
+        static_cast<float>(count - last.count) * MILLI_SECONDS_IN_SECOND / static_cast<float>(time_diff);
+    state_.publish(FpsCounterReading{count, ts, fps});
+  }
+
+public:
+  FpsBasicCounter() = default;
+  explicit FpsBasicCounter(Clock clock) : clock_(clock) {}
+  // Also feeds a rate estimator on every get_fps() and get_stats() call.
+  explicit FpsBasicCounter(const FpsEstimatorConfig& config, Clock clock = Clock{})
+      : estimator_(std::make_unique<FpsRateEstimator>(config)), clock_(clock) {}
+
+  count_type& set_status(int64_t value = 1) {
+    Concurrency::add(value_, static_cast<uint64_t>(value));
+    return value_;
+  }
+  uint64_t          total() const { return Concurrency::load(value_); }
+  // Reading published by the last window close.
+  FpsCounterReading reading() const { return state_.read(); }
+
+  float get_fps() { return get_fps_at(clock_.now_ms()); }
+  float get_fps_at(int64_t now_ms) {
+    const int64_t ts = now_ms;
+    if (estimator_) {
+      state_.lock();
+      estimator_->observe(ts, total());
+      close_window_(ts);
+      state_.unlock();
+      return state_.read().fps;
+    }
+    const FpsCounterReading last = state_.read();
+    // Another thread closing the same window publishes the same answer; no need to wait for it.
+    if (ts - last.ts < Window::MS || !state_.try_lock()) {
+      return last.fps;
+    }
+    close_window_(ts);
+    state_.unlock();
+    return state_.read().fps;
+  }
+
+  // Used to take wall clock epoch milliseconds; the timestamp is now on the Clock, so callers must switch domains.
+  [[deprecated("pass milliseconds on the counter's Clock to get_fps_at()")]] float get_fps(int64_t ts) {
+    return get_fps_at(now_(ts));
+  }
+
+  // Window rate, EWMA and the distribution of rates since the previous get_stats(); zeros without an estimator.
+  FpsRateStats get_stats() { return get_stats_at(clock_.now_ms()); }
+  FpsRateStats get_stats_at(int64_t now_ms) {
+    if (!estimator_) {
+      return FpsRateStats{};
+    }
+    state_.lock();
+    estimator_->observe(now_ms, total());
+    const FpsRateStats stats = estimator_->current();
+    estimator_->close_interval();
+    state_.unlock();
+    return stats;
+  }
+  [[deprecated("pass milliseconds on the counter's Clock to get_stats_at()")]] FpsRateStats get_stats(int64_t ts) {
+    return get_stats_at(now_(ts));
+  }
+};
+
+// Ten second window, any FpsClock, safe for any mix of counting and reading threads.
+using FpsCounter = FpsBasicCounter<>;
+extern template class FPSUTIL_EXPORT FpsBasicCounter<>;
+
 #endif // fps_counter_h
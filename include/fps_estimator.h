@@ -0,0 +1,110 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#pragma once
+#ifndef fps_estimator_h
+#define fps_estimator_h
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <fpsutil_export.h>
+
+constexpr size_t FPS_MAX_WINDOW_BUCKETS = 64;
+
+struct FpsEstimatorConfig {
+  // The sliding window spans buckets * bucket; bucket counts above FPS_MAX_WINDOW_BUCKETS are clamped. When
+  // observations are further apart than the window, the window rate covers the whole gap since the previous one.
+  std::chrono::milliseconds bucket{100};
+  size_t                    buckets{10};
+  // Time constant of the exponentially weighted moving average.
+  std::chrono::milliseconds ewma_tau{1000};
+};
+
+struct FpsRateStats {
+  float    window{0.0};
+  float    ewma{0.0};
+  // Distribution of the instantaneous rate (one value per observation) over the last closed interval.
+  float    min{0.0};
+  float    max{0.0};
+  float    p50{0.0};
+  float    p99{0.0};
+  uint32_t samples{0};
+};
+
+// Log-linear histogram of rates: eight sub-buckets per power of two up to 2^16 fps, about 12% resolution.
+class FpsRateHistogram {
+private:
+  static constexpr size_t SUB_BUCKETS = 8;
+  static constexpr size_t OCTAVES     = 17;
+  static constexpr size_t SIZE        = 1 + SUB_BUCKETS * OCTAVES;
+
+  std::array<uint32_t, SIZE> counts_{};
+  uint32_t                   count_{0};
+  float                      min_{0.0};
+  float                      max_{0.0};
+
+  static size_t index_(float fps);
+  static float  value_(size_t index);
+
+public:
+  void     record(float fps);
+  float    quantile(double q) const;
+  float    min() const { return min_; }
+  float    max() const { return max_; }
+  uint32_t count() const { return count_; }
+  void     reset();
+};
+
+// Turns successive (time, cumulative count) observations into a sliding-window rate over sub-second buckets, an EWMA
+// and the distribution of instantaneous rates. Every observation is O(1) amortised and the memory is fixed, so one
+// can be attached to any channel. Only the owner observes; other threads read the published values.
+class FPSUTIL_EXPORT FpsRateEstimator {
+private:
+  int64_t                                      bucket_ms_;
+  size_t                                       buckets_;
+  float                                        ewma_tau_ms_;
+  std::array<uint64_t, FPS_MAX_WINDOW_BUCKETS> window_{};
+  std::array<int64_t, FPS_MAX_WINDOW_BUCKETS>  since_{}; // start of the earliest observation counted in the bucket
+  uint64_t                                     window_sum_{0};
+  int64_t                                      head_{0}; // absolute bucket number of the newest bucket
+  bool                                         has_last_{false};
+  int64_t                                      last_ts_{0};
+  uint64_t                                     last_total_{0};
+  uint32_t                                     generation_{0};
+  float                                        ewma_{0.0};
+  bool                                         has_ewma_{false};
+  FpsRateHistogram                             histogram_;
+
+  std::atomic<float>   published_window_{0.0};
+  std::atomic<float>   published_ewma_{0.0};
+  std::atomic<float>   published_min_{0.0};
+  std::atomic<float>   published_max_{0.0};
+  std::atomic<float>   published_p50_{0.0};
+  std::atomic<float>   published_p99_{0.0};
+  std::atomic_uint32_t published_samples_{0};
+
+  void advance_(int64_t bucket);
+
+public:
+  explicit FpsRateEstimator(const FpsEstimatorConfig& config = FpsEstimatorConfig{});
+
+  // A generation change (the channel's cell was reused) or a counter going backwards starts over.
+  void observe(int64_t now_ms, uint64_t total, uint32_t generation = 0);
+  // Publishes the distribution seen since the previous call and starts a new interval.
+  void close_interval();
+  void reset();
+
+  float        window_rate() const;
+  float        ewma() const { return ewma_; }
+  // Current interval, without closing it. Owner only.
+  FpsRateStats current() const;
+  // Last published values; safe from any thread.
+  FpsRateStats published() const;
+};
+
+#endif // fps_estimator_h
@@ -0,0 +1,61 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#pragma once
+#ifndef fps_exporter_h
+#define fps_exporter_h
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <fpsutil_export.h>
+
+// Serves Prometheus text exposition over HTTP on a local endpoint: "host:port" or ":port" for TCP (IPv4, loopback when
+// the host is omitted) or "unix:/path" for a Unix domain socket. The monitor renders the whole response once per
+// sampling pass into the back buffer and swaps it in, so a scrape is one write of the front buffer and never touches
+// the registry. A buffer is only reused once no scrape still holds it. POSIX only; open() fails elsewhere.
+class FPSUTIL_EXPORT FpsExporter {
+private:
+  using clock_type = std::chrono::steady_clock;
+
+  int                          listen_fd_{-1};
+  int                          wake_fds_[2]{-1, -1}; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+  std::string                  unix_path_;
+  std::unique_ptr<std::thread> thread_;
+  std::atomic_uint64_t         scrapes_{0};
+
+  std::mutex                         front_mtx_;
+  std::shared_ptr<const std::string> front_;
+  std::shared_ptr<std::string>       back_;
+
+  void                               run_();
+  void                               serve_(int fd);
+  // False on timeout or once close() has been called.
+  bool                               wait_(int fd, short events, clock_type::time_point deadline);
+  bool                               send_(int fd, const char* data, size_t size);
+  std::shared_ptr<const std::string> front_buffer_();
+
+public:
+  FpsExporter() = default;
+  ~FpsExporter();
+  FpsExporter(const FpsExporter&)            = delete;
+  FpsExporter& operator=(const FpsExporter&) = delete;
+  FpsExporter(FpsExporter&&)                 = delete;
+  FpsExporter& operator=(FpsExporter&&)      = delete;
+
+  bool open(const std::string& endpoint);
+  void close();
+  bool is_open() const { return listen_fd_ >= 0; }
+  // Builds the HTTP response around body in the back buffer and makes it the one served from now on.
+  void     publish(std::string_view body);
+  uint64_t scrapes() const { return scrapes_.load(std::memory_order_relaxed); }
+};
+
+#endif // fps_exporter_h
@@ -0,0 +1,128 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#pragma once
+#ifndef fps_health_h
+#define fps_health_h
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <fps_registry.h>
+#include <fpsutil_export.h>
+
+enum class FpsHealthState : uint8_t {
+  UNKNOWN, // registered, but not yet ticking for a full sampling interval
+  HEALTHY,
+  DEGRADED, // rate over the last sampling pass outside the rule's range
+  STALLED,  // no tick for the rule's stall timeout
+};
+
+FPSUTIL_EXPORT const char* to_string(FpsHealthState state);
+
+struct FpsHealthRule {
+  float min_fps{8.0};
+  float max_fps{1000.0};
+  // Zero disables stall detection.
+  std::chrono::milliseconds stall_timeout{0};
+};
+
+struct FpsHealthEvent {
+  FpsKey         key;
+  FpsHealthState from{FpsHealthState::UNKNOWN};
+  FpsHealthState to{FpsHealthState::UNKNOWN};
+  float          fps{0.0};
+  int64_t        idle_ms{0}; // time since the channel last ticked
+  int64_t        ts{0};      // wall clock, milliseconds
+
+  bool is_recovery() const {
+    return to == FpsHealthState::HEALTHY && (from == FpsHealthState::DEGRADED || from == FpsHealthState::STALLED);
+  }
+};
+
+using FpsHealthCallback = std::function<void(const FpsHealthEvent&)>;
+
+// Per-channel health state machine. Rules are resolved per (app, channel), then per app, then the default. check()
+// runs on the monitor thread after every sampling pass and on the faster health cadence in between: stalls are seen
+// from the counters directly, so they surface within one health interval of the timeout, while the rate range is
+// judged on the last sampling pass. Transitions go to the subscribed callbacks, called on the monitor thread, and,
+// once event_fd() has been asked for, to a bounded queue read with drain().
+class FPSUTIL_EXPORT FpsHealth {
+private:
+  static constexpr size_t MAX_QUEUED_EVENTS = 4096;
+
+  struct Channel {
+    bool           is_tracked{false};
+    uint32_t       generation{0};
+    FpsHealthState state{FpsHealthState::UNKNOWN};
+    uint64_t       last_total{0};
+    int64_t        last_tick_ms{0};
+    uint64_t       first_pass{0}; // rates are judged from two sampling passes after this one
+    uint64_t       rule_version{0};
+    FpsHealthRule  rule;
+  };
+
+  mutable std::mutex                                     rules_mtx_;
+  FpsHealthRule                                          default_rule_;
+  std::map<uint64_t, FpsHealthRule>                      app_rules_;
+  std::map<std::pair<uint64_t, uint64_t>, FpsHealthRule> channel_rules_;
+  std::atomic_uint64_t                                   rules_version_{1};
+
+  // Owned by the thread running check().
+  std::vector<Channel>        channels_;
+  std::vector<FpsHealthEvent> pending_;
+
+  std::mutex                                          callbacks_mtx_;
+  std::vector<std::pair<uint64_t, FpsHealthCallback>> callbacks_;
+  uint64_t                                            next_callback_id_{1};
+
+  std::mutex                 events_mtx_;
+  std::deque<FpsHealthEvent> events_;
+  uint64_t                   dropped_events_{0};
+  int                        event_fd_{-1};
+
+  void dispatch_();
+
+public:
+  FpsHealth() = default;
+  ~FpsHealth();
+  FpsHealth(const FpsHealth&)            = delete;
+  FpsHealth& operator=(const FpsHealth&) = delete;
+  FpsHealth(FpsHealth&&)                 = delete;
+  FpsHealth& operator=(FpsHealth&&)      = delete;
+
+  void          set_rule(const FpsHealthRule& rule);
+  void          set_rule(uint64_t app_id, const FpsHealthRule& rule);
+  void          set_rule(uint64_t app_id, uint64_t channel_id, const FpsHealthRule& rule);
+  void          clear_rule(uint64_t app_id);
+  void          clear_rule(uint64_t app_id, uint64_t channel_id);
+  FpsHealthRule rule(const FpsKey& key) const;
+
+  uint64_t subscribe(FpsHealthCallback callback);
+  bool     unsubscribe(uint64_t id);
+  // Linux eventfd that becomes readable whenever transitions are queued; -1 where eventfd is not available.
+  int                         event_fd();
+  std::vector<FpsHealthEvent> drain();
+  // Events discarded because the queue was full.
+  uint64_t                    dropped_events();
+
+  // sample_passes counts the monitor's sampling passes; now_ms is on its monotonic clock.
+  void check(const FpsRegistry& registry, uint64_t sample_passes, int64_t now_ms, int64_t wall_ms);
+  // Transitions found by the last check() and the current state of a channel; for the thread running check().
+  const std::vector<FpsHealthEvent>& transitions() const { return pending_; }
+  FpsHealthState                     state(const FpsStatus& status) const;
+  // Rule cached for the channel in a cell by the last check(), resolved again only when the rules change; falls back
+  // to rule(key) for a cell check() has not seen at this generation. For the thread running check().
+  FpsHealthRule cached_rule(size_t index, uint32_t generation, const FpsKey& key) const;
+};
+
+#endif // fps_health_h
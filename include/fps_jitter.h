@@ -0,0 +1,70 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#pragma once
+#ifndef fps_jitter_h
+#define fps_jitter_h
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <fps_clock.h>
+#include <fpsutil_export.h>
+
+struct FpsJitterStats {
+  uint32_t gaps{0};
+  // Inter-arrival gaps in milliseconds.
+  float p50{0.0};
+  float p99{0.0};
+  float max{0.0};
+};
+
+// Histogram of the gap between consecutive ticks of one channel, in microseconds, with four sub-buckets per power of
+// two (HDR style, about 25% resolution) up to about a minute. Recording is one read of FpsClock::tick_clock(), one
+// exchange and one relaxed increment; nothing locks or allocates.
+class FPSUTIL_EXPORT FpsJitter {
+private:
+  static constexpr size_t   SUB_BUCKET_BITS = 2;
+  static constexpr size_t   SUB_BUCKETS     = 1U << SUB_BUCKET_BITS;
+  static constexpr size_t   BUCKETS         = SUB_BUCKETS * 26;
+  static constexpr uint64_t NS_IN_US        = 1000;
+
+  std::atomic_int64_t                       last_tick_ns_{0};
+  std::array<std::atomic_uint32_t, BUCKETS> buckets_{};
+
+  static size_t index_(uint64_t gap_us) {
+    if (gap_us < SUB_BUCKETS) {
+      return static_cast<size_t>(gap_us);
+    }
+    size_t exponent = 0;
+    for (uint64_t v = gap_us; v > 1; v >>= 1U) {
+      exponent++;
+    }
+    const size_t sub   = static_cast<size_t>(gap_us >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+    const size_t index = SUB_BUCKETS * (exponent - 1) + sub;
+    return index < BUCKETS ? index : BUCKETS - 1;
+  }
+  static float value_ms_(size_t index);
+
+public:
+  void record(int64_t now_ns) {
+    const int64_t last = last_tick_ns_.exchange(now_ns, std::memory_order_relaxed);
+    if (last != 0 && now_ns > last) {
+      record_gap(static_cast<uint64_t>(now_ns - last));
+    }
+  }
+  // Adds a gap measured elsewhere, e.g. between two pipeline stages (see FpsLatency).
+  void record_gap(uint64_t gap_ns) {
+    buckets_[index_(gap_ns / NS_IN_US)].fetch_add(1, std::memory_order_relaxed);
+  }
+  void record() { record(FpsClock::tick_clock().now_ns()); }
+  // Percentiles of the gaps recorded since the previous reading; with reset the histogram starts over.
+  FpsJitterStats read(bool reset);
+  // Forgets the previous tick too, so a reused channel does not report the gap across owners.
+  void clear();
+};
+
+#endif // fps_jitter_h
@@ -0,0 +1,143 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#pragma once
+#ifndef fps_latency_h
+#define fps_latency_h
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <fps_clock.h>
+#include <fps_jitter.h>
+#include <fps_slab.h>
+#include <fpsutil_export.h>
+
+constexpr size_t FPS_MAX_STAGES = 8;
+
+struct FpsLatencyStage {
+  uint64_t       thread_id{0};
+  FpsJitterStats from_previous; // since the same frame was marked by the stage before this one
+  FpsJitterStats from_first;    // since the same frame was marked by the first stage
+};
+
+struct FpsLatencyStats {
+  uint64_t                     app_id{0};
+  uint64_t                     channel_id{0};
+  std::vector<FpsLatencyStage> stages; // in pipeline order
+};
+
+// Frame latency between the stages (thread ids) of one (app, channel). Each stage keeps a ring of the last FRAME_SLOTS
+// stamps indexed by frame id, one word per stamp holding a frame tag and the low bits of the tick clock. A mark stores
+// its stamp and looks up the same frame in the previous and the first stage, so it is one clock read, one store, two
+// loads and up to two relaxed increments; frames evicted from the ring before the next stage marks them are not
+// counted. Memory is fixed per channel. The generation moves on when the pipeline is dropped, so handles can tell.
+class FPSUTIL_EXPORT FpsLatency {
+private:
+  static constexpr size_t   FRAME_SLOTS = 256;
+  static constexpr uint64_t TS_BITS     = 40; // about 18 minutes of nanoseconds
+  static constexpr uint64_t TS_MASK     = (uint64_t{1} << TS_BITS) - 1;
+  static constexpr uint64_t VALID       = uint64_t{1} << 63U;
+
+  struct alignas(FPS_CACHE_LINE_SIZE) Stage {
+    std::array<std::atomic_uint64_t, FRAME_SLOTS> stamps{};
+    FpsJitter                                     from_previous;
+    FpsJitter                                     from_first;
+  };
+
+  uint64_t                             app_id_;
+  uint64_t                             channel_id_;
+  std::mutex                           mtx_;
+  std::array<uint64_t, FPS_MAX_STAGES> ids_{};
+  std::atomic_uint32_t                 stage_count_{0};
+  std::atomic_uint32_t                 generation_{0};
+  std::array<Stage, FPS_MAX_STAGES>    stages_;
+
+  static uint64_t tag_(uint64_t frame_id) { return VALID | ((frame_id << TS_BITS) & ~VALID); }
+
+public:
+  FpsLatency(uint64_t app_id, uint64_t channel_id) : app_id_(app_id), channel_id_(channel_id) {}
+
+  // Position of the stage in the pipeline, appending it on first use; -1 once FPS_MAX_STAGES are taken.
+  int      stage(uint64_t thread_id);
+  bool     has_stage(uint64_t thread_id);
+  uint32_t generation() const { return generation_.load(std::memory_order_acquire); }
+  // Invalidates every handle; the pipeline is not marked again until reset() hands it to another channel.
+  void     retire() { generation_.fetch_add(1, std::memory_order_release); }
+  void     reset(uint64_t app_id, uint64_t channel_id);
+  void     mark(uint32_t stage, uint64_t frame_id, int64_t now_ns) {
+    const uint64_t tag  = tag_(frame_id);
+    const size_t   slot = frame_id % FRAME_SLOTS;
+    stages_[stage].stamps[slot].store(tag | (static_cast<uint64_t>(now_ns) & TS_MASK), std::memory_order_relaxed);
+    if (stage == 0) {
+      return;
+    }
+    const uint64_t previous = stages_[stage - 1].stamps[slot].load(std::memory_order_relaxed);
+    if ((previous & ~TS_MASK) == tag) {
+      stages_[stage].from_previous.record_gap((static_cast<uint64_t>(now_ns) - previous) & TS_MASK);
+    }
+    if (stage == 1) {
+      return;
+    }
+    const uint64_t first = stages_[0].stamps[slot].load(std::memory_order_relaxed);
+    if ((first & ~TS_MASK) == tag) {
+      stages_[stage].from_first.record_gap((static_cast<uint64_t>(now_ns) - first) & TS_MASK);
+    }
+  }
+  // Percentiles since the previous reading; with reset the histograms start over.
+  FpsLatencyStats read(bool reset);
+};
+
+// A stage of one traced channel, resolved once so marking skips every lookup.
+struct FpsTraceHandle {
+  FpsLatency* pipeline{nullptr};
+  uint32_t    stage{0};
+  uint32_t    generation{0};
+
+  bool valid() const { return pipeline != nullptr && pipeline->generation() == generation; }
+  bool mark(uint64_t frame_id) const {
+    if (!valid()) {
+      return false;
+    }
+    pipeline->mark(stage, frame_id, FpsClock::tick_clock().now_ns());
+    return true;
+  }
+};
+
+// Pipelines of one monitor. Only declare() creates one; a dropped pipeline is kept in a pool and reused by a later
+// declare(), so handles never point at freed memory and the pool is bounded by the most pipelines traced at once.
+class FPSUTIL_EXPORT FpsTracer {
+private:
+  std::mutex                                           mtx_;
+  std::map<std::pair<uint64_t, uint64_t>, FpsLatency*> pipelines_;
+  std::vector<std::unique_ptr<FpsLatency>>             storage_;
+  std::vector<FpsLatency*>                             free_;
+  std::atomic_uint64_t                                 version_{0};
+
+  FpsLatency* find_(uint64_t app_id, uint64_t channel_id);
+  void        drop_(std::map<std::pair<uint64_t, uint64_t>, FpsLatency*>::iterator it);
+
+public:
+  // Declares the pipeline and its stage order up front; false when a stage could not be placed at its position.
+  bool            declare(uint64_t app_id, uint64_t channel_id, const std::vector<uint64_t>& stages);
+  // Invalid handle when the channel is not traced.
+  FpsTraceHandle  handle(uint64_t app_id, uint64_t channel_id, uint64_t thread_id);
+  // Drops the pipeline of a channel; the key form only when the key's thread is one of its stages. True when dropped.
+  bool            remove(uint64_t app_id, uint64_t channel_id);
+  bool            remove(const FpsKey& key);
+  // Moves on whenever a pipeline is declared or dropped, so cached invalid handles know when to look again.
+  uint64_t        version() const { return version_.load(std::memory_order_acquire); }
+  FpsLatencyStats read(uint64_t app_id, uint64_t channel_id, bool reset);
+  // Every pipeline with at least two stages, in key order.
+  void            read_all(std::vector<FpsLatencyStats>& out, bool reset);
+};
+
+#endif // fps_latency_h
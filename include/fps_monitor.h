@@ -7,72 +7,297 @@
 #define fps_monitor_h
 
 #include <atomic>
-#include <map>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <spdlog/spdlog.h>
 #include <string>
-#include <thread>
+#include <vector>
 
 #include <fpsutil_export.h>
+#include <fps_batch.h>
+#include <fps_clock.h>
+#include <fps_exporter.h>
+#include <fps_health.h>
+#include <fps_latency.h>
 #include <fps_monitor_c.h>
+#include <fps_recorder.h>
+#include <fps_registry.h>
+#include <fps_rollup.h>
+#include <fps_shm.h>
+#include <fps_snapshot.h>
+#include <fps_stats.h>
+#include <fps_subscription.h>
 
-struct FpsStatus {
-  std::atomic_uint_fast64_t app_id;
-  std::atomic_uint_fast64_t channel_id;
-  std::atomic_uint_fast64_t thread_id;
-  std::atomic_uint_fast64_t value;
-  std::atomic_uint_fast64_t last_value;
-  std::atomic_bool          dump_in_log;
-  std::atomic<float>        last_fps{0.0};
-
-  FpsStatus(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, bool dump_in_log);
-  FpsStatus(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, uint64_t value, uint64_t last_value,
-            bool dump_in_log);
-  ~FpsStatus() = default;
+struct FpsMonitorConfig {
+  // Counters are turned into rates every sample_interval and written to the logs every log_interval.
+  // Both are clamped to MIN_INTERVAL.
+  static constexpr std::chrono::milliseconds MIN_INTERVAL{100};
+
+  std::chrono::milliseconds sample_interval{10000};
+  std::chrono::milliseconds log_interval{10000};
+  // Channels that have not ticked for longer than idle_ttl are unregistered; zero keeps them forever.
+  std::chrono::milliseconds idle_ttl{0};
+  // Health checks (see FpsHealth) run after every sampling pass and, when non-zero, also every health_interval, so
+  // stalls are caught well before the next sample. Clamped to MIN_INTERVAL.
+  std::chrono::milliseconds health_interval{0};
+  // Manual monitors are skipped by the group thread; their owner drives every pass through FpsMonitor::step().
+  bool manual{false};
+  // Appends the monitor's own cost (see FpsSelfStats) to the summary log on every log pass.
+  bool log_self_stats{false};
+  // Change-only logging: with a positive log_epsilon a log pass writes only the channels whose rate moved by more than
+  // log_epsilon fps since they were last written or that crossed their health rule, and the Valid/Invalid lines list
+  // only the keys that changed side. Every log_keyframe_passes-th pass, and the first pass after each header, writes
+  // every channel. Entries keep their "App.Chn.Thr fps|" layout, so carrying values forward from the last full line
+  // rebuilds every pass.
+  float    log_epsilon{0.0};
+  uint32_t log_keyframe_passes{6};
+  // Also writes every log pass to the binary recording <session_dir>/<file_name>.fpsr (see FpsRecordReader), which
+  // rotates with the same size and file count as the text logs.
+  bool record{false};
+  // When set, every sampling pass is also published to the shared-memory segment of this name (see FpsShmReader),
+  // sized for shm_capacity channels. Both are fixed when the monitor is created.
+  std::string shm_name;
+  size_t      shm_capacity{4096};
+  // When set, every sampling pass is also rendered as Prometheus text and served on this endpoint (see FpsExporter):
+  // "host:port", ":port" or "unix:/path". Fixed when the monitor is created.
+  std::string metrics_endpoint;
+  // Source of sampling intervals and log timestamps; nullptr means FpsClock::steady(). Fixed when the monitor is
+  // created and must outlive it.
+  const FpsClock* clock{nullptr};
 };
 
+class FpsMonitorGroup;
+
 class FPSUTIL_EXPORT FpsMonitor {
 private:
+  using clock_type = std::chrono::steady_clock;
+
   bool             is_already_shutting_down_{false};
   std::atomic_bool do_shutdown_{false};
   std::atomic_bool is_internal_shutdown_{false};
 
-  std::string session_dir_;
-  std::string file_name_;
+  FpsMonitorGroup& group_;
+  std::string      name_;
+  std::string      session_dir_;
+  std::string      file_name_;
+
+  // Scheduling state, guarded by the group's mutex and only acted upon by the group thread.
+  FpsMonitorConfig       config_;
+  bool                   do_reschedule_{false};
+  bool                   is_started_{false};
+  bool                   is_closed_{false};
+  std::atomic_bool       is_thread_requested_{false};
+  clock_type::time_point next_sample_;
+  clock_type::time_point next_log_;
+  clock_type::time_point next_health_;
+  uint64_t               last_layout_version_{0};
+  size_t                 last_timed_count_{0};
+
+  std::shared_ptr<spdlog::logger> logger_;
+  std::shared_ptr<spdlog::logger> summary_logger_;
+
+  FpsRegistry registry_;
+
+  const FpsClock* clock_;
+  int64_t         last_write_ts_;
+  int64_t         last_sample_ts_{0};
+  bool            do_write_header_{false};
+
+  FpsSnapshot          snapshot_;
+  size_t               snapshot_timed_count_{0}; // logged channels in the snapshot that carry jitter columns
+  std::vector<FpsKey>  valid_list_;
+  std::vector<FpsKey>  invalid_list_;
+  spdlog::memory_buf_t line_buffer_;
+  spdlog::memory_buf_t header_buffer_;
+  std::atomic_int64_t  snapshot_duration_ns_{0};
+  std::atomic_int64_t  idle_ttl_ms_{0};
+  std::atomic_bool     log_self_stats_{false};
+  std::atomic<float>   log_epsilon_{0.0};
+  std::atomic_uint32_t log_keyframe_passes_{0};
+
+  // Registry cell behind each snapshot sample, so the log pass reads the health rule cached for it.
+  struct SnapshotCell {
+    uint32_t index{0};
+    uint32_t generation{0};
+  };
+  std::vector<SnapshotCell> snapshot_cells_;
+
+  // What the last log pass wrote for each channel, in snapshot order; owned by the monitor thread.
+  struct LoggedChannel {
+    FpsKey key;
+    float  fps{0.0};
+    bool   is_valid{false};
+  };
+  std::vector<LoggedChannel> logged_;
+  uint32_t                   passes_since_keyframe_{0};
 
-  std::unique_ptr<std::thread> thread_;
+  FpsHistogram       sample_pass_;
+  FpsHistogram       log_pass_;
+  FpsSinkStats       log_sink_;
+  FpsSinkStats       summary_sink_;
+  uint64_t           last_registrations_{0};
+  std::atomic<float> registration_rate_{0.0};
 
-  std::mutex resource_map_mtx_;
-  std::mutex resource_map_reference_mtx_;
+  FpsShmWriter shm_;
+  std::string  shm_name_;
+  size_t       shm_capacity_{0};
+  bool         is_shm_failed_{false};
 
-  std::map<std::tuple<uint64_t, uint64_t, uint64_t>, std::unique_ptr<FpsStatus>> resource_map_;
-  std::map<std::tuple<uint64_t, uint64_t, uint64_t>, std::atomic_uint_fast64_t&> resource_map_reference_;
+  FpsExporter          exporter_;
+  std::string          metrics_endpoint_;
+  bool                 is_exporter_failed_{false};
+  spdlog::memory_buf_t metrics_buffer_;
 
-  int64_t last_write_ts_;
-  bool    do_write_header_{false};
+  FpsRecorder      recorder_;
+  std::atomic_bool do_record_{false};
+  bool             is_record_failed_{false};
+
+  FpsTickBuffers tick_buffers_;
+
+  FpsHealth health_;
+  FpsRollup rollup_;
+  FpsTracer tracer_;
+  uint64_t  sample_passes_{0};
+
+  // Refilled in place on every pass: the rollup nodes the log pass prints and the channels evicted as idle.
+  std::vector<FpsRollupNode> rollup_apps_;
+  std::vector<FpsRollupNode> rollup_channels_;
+  std::vector<FpsKey>        evicted_;
+
+  std::mutex                                    subscriptions_mtx_;
+  std::vector<std::shared_ptr<FpsSubscription>> subscriptions_;
+  std::atomic_bool                              has_subscriptions_{false};
 
   std::atomic_uint_fast64_t& set_status_(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, bool dump_in_log);
+  FpsStatus&                 acquire_(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, bool dump_in_log);
   void                set_status_reference_(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, bool dump_in_log);
   std::atomic<float>& get_fps_(uint64_t app_id, uint64_t channel_id, uint64_t thread_id);
   void                calculate_fps_();
+  void                take_snapshot_(bool close_interval);
+  void                sample_(bool close_interval = false);
+  void                publish_();
+  void                export_();
+  void                check_health_();
+  void                notify_subscriptions_();
+  void                close_subscriptions_();
 
   void write_data_(std::shared_ptr<spdlog::logger> logger_, std::shared_ptr<spdlog::logger> summary_logger_);
   void write_header_(std::shared_ptr<spdlog::logger> logger_, std::shared_ptr<spdlog::logger> summary_logger_);
-  void run_();
 
-  FpsMonitor(std::string session_dir, std::string file_name);
+  // Every registration goes through insert_(), so the first one can start the group thread.
+  std::pair<FpsStatus*, bool> insert_(const FpsKey& key, bool dump_in_log);
+  void                        request_thread_();
+
+  clock_type::time_point next_deadline_() const;
+  void                   service_(std::unique_lock<std::mutex>& lock, clock_type::time_point now);
+  void                   open_loggers_();
+  void                   log_();
+  void                   final_pass_();
+
+  FpsMonitor(FpsMonitorGroup& group, std::string name, std::string session_dir, std::string file_name,
+             const FpsMonitorConfig& config);
   void shutDown();
   ~FpsMonitor();
   static FpsMonitor& getInstance();
 
+  friend class FpsMonitorGroup;
+  friend struct std::default_delete<FpsMonitor>;
+
 public:
+  FpsMonitor(const FpsMonitor&)            = delete;
+  FpsMonitor& operator=(const FpsMonitor&) = delete;
+  FpsMonitor(FpsMonitor&&)                 = delete;
+  FpsMonitor& operator=(FpsMonitor&&)      = delete;
+
   static FpsMonitor&                getInstance(std::string session_dir, std::string file_name);
   static std::atomic_uint_fast64_t& set_status(uint64_t app_id, uint64_t channel_id, uint64_t thread_id,
                                                bool dump_in_log = true);
   static void set_status_reference(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, bool dump_in_log = true);
+  static std::atomic_uint_fast64_t& acquire(uint64_t app_id, uint64_t channel_id, uint64_t thread_id,
+                                            bool dump_in_log = true);
+  static FpsHandle get_handle(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, bool dump_in_log = true);
+  static bool      unregister(uint64_t app_id, uint64_t channel_id, uint64_t thread_id);
+  static bool      enable_striping(uint64_t app_id, uint64_t channel_id, uint64_t thread_id,
+                              size_t stripe_count = FPS_MAX_STRIPES);
   static std::atomic<float>& get_fps(uint64_t app_id, uint64_t channel_id, uint64_t thread_id);
+  static int64_t             get_snapshot_duration_ns();
+  static void                configure(const FpsMonitorConfig& config);
+  static FpsSelfStats        get_self_stats();
+  static bool                enable_estimator(uint64_t app_id, uint64_t channel_id, uint64_t thread_id,
+                                              const FpsEstimatorConfig& config = FpsEstimatorConfig{});
+  static FpsRateStats        get_rate_stats(uint64_t app_id, uint64_t channel_id, uint64_t thread_id);
+  static bool                enable_timing(uint64_t app_id, uint64_t channel_id, uint64_t thread_id);
+  static FpsJitterStats      get_jitter(uint64_t app_id, uint64_t channel_id, uint64_t thread_id);
+  static size_t              tick_batch(const FpsTick* ticks, size_t count);
+  static size_t              tick_batch(const FpsKeyTick* ticks, size_t count, bool dump_in_log = true);
+  static FpsHealth&          get_health();
+  static const FpsRollup&    get_rollup();
+  static std::shared_ptr<FpsSubscription>
+  subscribe_snapshots(const FpsSubscriptionConfig& config = FpsSubscriptionConfig{});
+  static bool                enable_tracing(uint64_t app_id, uint64_t channel_id, const std::vector<uint64_t>& stages);
+  static bool                disable_tracing(uint64_t app_id, uint64_t channel_id);
+  static FpsTraceHandle      get_trace_handle(uint64_t app_id, uint64_t channel_id, uint64_t thread_id);
+  static bool                mark_frame(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, uint64_t frame_id);
+  static FpsLatencyStats     get_latency(uint64_t app_id, uint64_t channel_id);
   static void                close();
+
+  static std::vector<FpsHandle> get_handles(const std::vector<FpsKey>& keys, bool dump_in_log = true);
+  static void                   reserve_channels(size_t count);
+  // Reads one app.channel.thread key per line, as printed in the log header; blank lines and lines starting with '#'
+  // are skipped. False when the file cannot be read or a line does not parse.
+  static bool                   read_keys(const std::string& path, std::vector<FpsKey>& keys);
+
+  // Instance API for monitors created through FpsMonitorGroup; the static functions above act on the default one.
+  const std::string&         name() const { return name_; }
+  std::atomic_uint_fast64_t& status(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, bool dump_in_log = true);
+  std::atomic_uint_fast64_t& counter(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, bool dump_in_log = true);
+  std::atomic<float>&        fps(uint64_t app_id, uint64_t channel_id, uint64_t thread_id);
+  FpsHandle handle(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, bool dump_in_log = true);
+  // Registers all keys in one pass over the registry and returns their handles in the same order. The sampling thread
+  // and the log files are only created once the first channel is registered and the first log pass is due.
+  std::vector<FpsHandle> handles(const std::vector<FpsKey>& keys, bool dump_in_log = true);
+  void                   reserve(size_t channels) { registry_.reserve(channels); }
+  bool      remove(uint64_t app_id, uint64_t channel_id, uint64_t thread_id);
+  bool    stripe(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, size_t stripe_count = FPS_MAX_STRIPES);
+  int64_t snapshot_duration_ns() const { return snapshot_duration_ns_.load(std::memory_order_relaxed); }
+  FpsSelfStats self_stats() const;
+  // Window and EWMA follow every sampling pass; min/max/p50/p99 cover the sampling passes of the last log interval, so
+  // a sample_interval well below log_interval is what exposes short drops.
+  bool         estimate(uint64_t app_id, uint64_t channel_id, uint64_t thread_id,
+                        const FpsEstimatorConfig& config = FpsEstimatorConfig{});
+  FpsRateStats rate_stats(uint64_t app_id, uint64_t channel_id, uint64_t thread_id);
+  // Timed channels get inter-arrival jitter percentiles next to their FPS column; the log pass resets the histogram.
+  bool           timing(uint64_t app_id, uint64_t channel_id, uint64_t thread_id);
+  FpsJitterStats jitter(uint64_t app_id, uint64_t channel_id, uint64_t thread_id);
+  // Batched ticks go through the calling thread's coalescing buffer (see FpsTickBuffer) and reach the counters before
+  // the next sampling pass, or on flush_batches(). Key batches register unknown channels. Both return the number of
+  // elements accepted.
+  size_t batch(const FpsTick* ticks, size_t count);
+  size_t batch(const FpsKeyTick* ticks, size_t count, bool dump_in_log = true);
+  void   flush_batches() { tick_buffers_.flush(); }
+  // Rules, callbacks and the event queue of this monitor's health checks.
+  FpsHealth& health() { return health_; }
+  // Runs a health check now; for manual monitors, whose owner picks the cadence.
+  void       check_health() { check_health_(); }
+  // Per (app, channel), per app and process-wide totals, updated on every sampling pass and health check.
+  const FpsRollup& rollup() const { return rollup_; }
+  // Every later sampling pass is delivered to the subscription as an immutable snapshot. Dropping the last reference or
+  // calling close() ends it; so does the monitor's shutdown, after the final pass.
+  std::shared_ptr<FpsSubscription> subscribe(const FpsSubscriptionConfig& config = FpsSubscriptionConfig{});
+  // Frame latency between the stages (thread ids) of a channel, reported in the summary log next to the rates. Only
+  // trace() starts tracing a channel; handles and marks for an untraced channel do nothing and return false. Stages
+  // are ordered as declared by trace() or else by their first mark; a handle marks without any lookup, while mark()
+  // resolves the stage through a per-thread cache. Histograms start over on every log pass. The pipeline is dropped by
+  // untrace(), or when one of its stages is unregistered or evicted as idle.
+  bool            trace(uint64_t app_id, uint64_t channel_id, const std::vector<uint64_t>& stages);
+  bool            untrace(uint64_t app_id, uint64_t channel_id);
+  FpsTraceHandle  trace_handle(uint64_t app_id, uint64_t channel_id, uint64_t thread_id);
+  bool            mark(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, uint64_t frame_id);
+  FpsLatencyStats latency(uint64_t app_id, uint64_t channel_id);
+  void    reconfigure(const FpsMonitorConfig& config);
+  void    step(bool do_log = true);
+  void    shutdown() { shutDown(); }
 };
 
 #endif // fps_monitor_h
@@ -7,10 +7,48 @@
 #define fps_monitor_c_h
 #include <fpsutil_export.h>
 #include <stdint.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 #ifdef __cplusplus
 extern "C" {
 #endif
-void FPSUTIL_EXPORT set_status(uint64_t app_id, uint64_t channel_id, uint64_t thread_id);
+/* Generation-checked channel reference: ticks are dropped once the channel has been unregistered. */
+typedef struct fps_handle_s {
+  uint64_t*       counter;
+  const uint32_t* generation;
+  uint32_t        expected;
+  void*           timing; /* set when the channel was in timing mode at acquire time */
+} fps_handle_t;
+
+void FPSUTIL_EXPORT         set_status(uint64_t app_id, uint64_t channel_id, uint64_t thread_id);
+fps_handle_t FPSUTIL_EXPORT fps_acquire(uint64_t app_id, uint64_t channel_id, uint64_t thread_id);
+int FPSUTIL_EXPORT          fps_unregister(uint64_t app_id, uint64_t channel_id, uint64_t thread_id);
+int FPSUTIL_EXPORT          fps_enable_striping(uint64_t app_id, uint64_t channel_id, uint64_t thread_id,
+                                                uint32_t stripe_count);
+int FPSUTIL_EXPORT          fps_enable_timing(uint64_t app_id, uint64_t channel_id, uint64_t thread_id);
+void FPSUTIL_EXPORT         fps_record_arrival(void* timing);
+
+/* A tick is a generation check on the counter's cache line plus a single relaxed atomic add; returns 0 once the
+ * channel is gone. On a striped channel the handle addresses the acquiring thread's stripe, so acquire it on the
+ * thread that ticks. Enable timing before acquiring, or the handle will not record arrivals. */
+static inline int fps_tick(fps_handle_t handle, uint64_t n) {
+#if defined(_MSC_VER)
+  if (*(const volatile uint32_t*)handle.generation != handle.expected) {
+    return 0;
+  }
+  _InterlockedExchangeAdd64((volatile __int64*)handle.counter, (__int64)n);
+#else
+  if (__atomic_load_n(handle.generation, __ATOMIC_RELAXED) != handle.expected) {
+    return 0;
+  }
+  __atomic_fetch_add(handle.counter, n, __ATOMIC_RELAXED);
+#endif
+  if (handle.timing) {
+    fps_record_arrival(handle.timing);
+  }
+  return 1;
+}
 #ifdef __cplusplus
 }
 #endif
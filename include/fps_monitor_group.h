@@ -0,0 +1,57 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#pragma once
+#ifndef fps_monitor_group_h
+#define fps_monitor_group_h
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <fps_monitor.h>
+#include <fpsutil_export.h>
+
+// Owns a set of named monitors and the single background thread that samples and logs all of them, each on its own
+// intervals. The thread starts when a monitor that is not manual registers its first channel. The static FpsMonitor
+// facade uses the "default" monitor of the process-wide group.
+class FPSUTIL_EXPORT FpsMonitorGroup {
+private:
+  std::mutex                                         mtx_;
+  std::condition_variable                            cv_;
+  std::map<std::string, std::unique_ptr<FpsMonitor>> monitors_;
+  std::unique_ptr<std::thread>                       thread_;
+  bool                                               is_running_{false};
+  bool                                               do_stop_{false};
+  bool                                               do_wake_{false};
+
+  void run_();
+  void wake_();  // caller holds mtx_
+  void start_(); // caller holds mtx_
+
+  friend class FpsMonitor;
+
+public:
+  static constexpr const char* DEFAULT_MONITOR = "default";
+
+  FpsMonitorGroup() = default;
+  ~FpsMonitorGroup();
+  FpsMonitorGroup(const FpsMonitorGroup&)            = delete;
+  FpsMonitorGroup& operator=(const FpsMonitorGroup&) = delete;
+  FpsMonitorGroup(FpsMonitorGroup&&)                 = delete;
+  FpsMonitorGroup& operator=(FpsMonitorGroup&&)      = delete;
+
+  static FpsMonitorGroup& getInstance();
+
+  // Returns the monitor registered under name, creating it with the given log location and intervals on first use.
+  FpsMonitor& create(const std::string& name, std::string session_dir, std::string file_name,
+                     const FpsMonitorConfig& config = FpsMonitorConfig{});
+  FpsMonitor* get(const std::string& name);
+  void        close();
+};
+
+#endif // fps_monitor_group_h
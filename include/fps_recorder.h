@@ -0,0 +1,102 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#pragma once
+#ifndef fps_recorder_h
+#define fps_recorder_h
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fps_snapshot.h>
+#include <fpsutil_export.h>
+
+// Binary time-series format (.fpsr). A file is the magic and version followed by records, each a type byte, a varint
+// payload length and the payload:
+//   DICTIONARY  varint first id, varint count, then app, channel, thread varints per new channel
+//   FRAME       zigzag timestamp delta (ms), varint count, then one column each of zigzag channel id deltas, zigzag
+//               counter deltas and zigzag centi-fps deltas, all relative to the channel's previous frame
+// Every file starts from empty state, so a rotated file can be read on its own.
+constexpr uint32_t FPS_RECORD_MAGIC   = 0x52535046; // "FPSR"
+constexpr uint32_t FPS_RECORD_VERSION = 1;
+
+// Appends snapshots to a size-rotated set of files: path, then path with .1, .2 ... before the extension.
+class FPSUTIL_EXPORT FpsRecorder {
+private:
+  struct Channel {
+    uint64_t value{0};
+    int64_t  centi_fps{0};
+  };
+  struct KeyHash {
+    size_t operator()(const FpsKey& key) const { return key.hash(); }
+  };
+
+  std::string                                        path_;
+  size_t                                             max_size_{0};
+  size_t                                             max_files_{0};
+  std::FILE*                                         file_{nullptr};
+  size_t                                             file_size_{0};
+  int64_t                                            last_ts_{0};
+  std::unordered_map<FpsKey, uint32_t, KeyHash>      ids_;
+  std::vector<FpsKey>                                keys_;
+  std::vector<Channel>                               channels_;
+  std::vector<std::pair<uint32_t, const FpsSample*>> frame_;
+  std::vector<uint8_t>                               payload_;
+  std::vector<uint8_t>                               dictionary_;
+
+  bool     open_file_();
+  void     shift_files_();
+  void     rotate_();
+  uint32_t id_(const FpsKey& key);
+  void     write_record_(uint8_t type, const std::vector<uint8_t>& payload);
+
+public:
+  FpsRecorder() = default;
+  ~FpsRecorder() { close(); }
+  FpsRecorder(const FpsRecorder&)            = delete;
+  FpsRecorder& operator=(const FpsRecorder&) = delete;
+  FpsRecorder(FpsRecorder&&)                 = delete;
+  FpsRecorder& operator=(FpsRecorder&&)      = delete;
+
+  // A non-empty file already at path becomes path.1 and the older ones move up, as on rotation.
+  bool open(std::string path, size_t max_size, size_t max_files);
+  bool is_open() const { return file_ != nullptr; }
+  // Records the channels marked dump_in_log, like the text log does.
+  void write(const FpsSnapshot& snapshot);
+  void close();
+};
+
+class FPSUTIL_EXPORT FpsRecordReader {
+private:
+  struct Channel {
+    uint64_t value{0};
+    int64_t  centi_fps{0};
+  };
+
+  std::FILE*            file_{nullptr};
+  int64_t               last_ts_{0};
+  std::vector<FpsKey>   keys_;
+  std::vector<Channel>  channels_;
+  std::vector<uint32_t> frame_ids_;
+  std::vector<uint8_t>  payload_;
+
+public:
+  FpsRecordReader() = default;
+  ~FpsRecordReader() { close(); }
+  FpsRecordReader(const FpsRecordReader&)            = delete;
+  FpsRecordReader& operator=(const FpsRecordReader&) = delete;
+  FpsRecordReader(FpsRecordReader&&)                 = delete;
+  FpsRecordReader& operator=(FpsRecordReader&&)      = delete;
+
+  bool open(const std::string& path);
+  // Decodes the next frame into snapshot; false at the end of the file or on a truncated or corrupt record.
+  bool next(FpsSnapshot& snapshot);
+  void close();
+};
+
+#endif // fps_recorder_h
@@ -0,0 +1,121 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#pragma once
+#ifndef fps_registry_h
+#define fps_registry_h
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <fps_slab.h>
+#include <fps_stats.h>
+#include <fpsutil_export.h>
+
+// Concurrent (app, channel, thread) -> FpsStatus index.
+// Lookups never lock; inserts serialise per shard and publish a grown table atomically, so readers keep probing the
+// old table until the new one is visible. The old table is freed FPS_RECLAIM_PASSES sampling passes later, the same
+// preemption bound the slab relies on for cells. Entries live in an FpsSlab so the monitor can walk a consistent prefix
+// without blocking producers.
+class FPSUTIL_EXPORT FpsRegistry {
+private:
+  static constexpr size_t SHARD_COUNT      = 64;
+  static constexpr size_t INITIAL_CAPACITY = 16;
+
+  struct Table {
+    size_t                                      mask;
+    std::unique_ptr<std::atomic<FpsStatus*>[]> slots; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    explicit Table(size_t capacity);
+  };
+
+  struct RetiredTable {
+    std::unique_ptr<Table> table;
+    uint64_t               pass;
+  };
+
+  struct Shard {
+    std::atomic<Table*>       table{nullptr};
+    size_t                    count{0}; // live entries plus tombstones in the current table
+    std::mutex                insert_mtx;
+    std::unique_ptr<Table>    current;
+    std::vector<RetiredTable> retired;
+  };
+
+  std::array<Shard, SHARD_COUNT> shards_;
+  FpsSlab                        slab_;
+  FpsHistogram                   lock_wait_;
+  FpsHistogram                   lock_hold_;
+  std::atomic_uint64_t           registrations_{0};
+  std::atomic_uint64_t           unregistrations_{0};
+  std::atomic_size_t             retired_tables_{0};
+
+  // Marks a removed slot so probes keep walking past it; dropped when the shard's table is rebuilt.
+  static FpsStatus tombstone_;
+
+  static FpsStatus* probe_(const Table* table, const FpsKey& key, uint64_t hash);
+  static void       place_(Table* table, FpsStatus* status, uint64_t hash);
+  Table*            rebuild_(Shard& shard, size_t live, size_t extra);
+  Table*            make_room_(Shard& shard, size_t extra);
+  void              reclaim_tables_();
+  Shard&            shard_(uint64_t hash) { return shards_[hash % SHARD_COUNT]; }
+  const Shard&      shard_(uint64_t hash) const { return shards_[hash % SHARD_COUNT]; }
+
+public:
+  FpsRegistry();
+  ~FpsRegistry();
+  FpsRegistry(const FpsRegistry&)            = delete;
+  FpsRegistry& operator=(const FpsRegistry&) = delete;
+  FpsRegistry(FpsRegistry&&)                 = delete;
+  FpsRegistry& operator=(FpsRegistry&&)      = delete;
+
+  FpsStatus*                  find(const FpsKey& key) const;
+  std::pair<FpsStatus*, bool> find_or_insert(const FpsKey& key, bool dump_in_log);
+  // Sizes every shard table and the slab for count more channels, so the inserts that follow neither rebuild nor
+  // allocate.
+  void                        reserve(size_t count);
+  // Registers count keys in one pass that takes each shard lock once; out[i] receives the cell of keys[i]. Returns the
+  // number of channels that were not registered yet.
+  size_t                      insert_bulk(const FpsKey* keys, size_t count, bool dump_in_log, FpsStatus** out);
+  bool                        remove(const FpsKey& key);
+  // Unregisters channels that have not ticked for ttl_ms, appending their keys to keys when given.
+  size_t                      evict_idle(int64_t now_ms, int64_t ttl_ms, std::vector<FpsKey>* keys = nullptr);
+  size_t                      size() const { return slab_.size(); }
+  size_t                      live() const { return slab_.live(); }
+  uint64_t                    layout_version() const { return slab_.layout_version(); }
+  FpsStatus&                  at(size_t index) const { return slab_.status(index); }
+  std::atomic<float>&         last_fps(const FpsStatus& status) const { return slab_.last_fps(status.index); }
+  float fps_at(size_t index) const { return slab_.last_fps(index).load(std::memory_order_relaxed); }
+  // Published rates of the channels from base (a multiple of FPS_SEGMENT_SIZE) to the end of its segment.
+  const std::atomic<float>* fps_block(size_t base) const { return &slab_.last_fps(base); }
+  uint64_t                    sample(const FpsStatus& status) const { return slab_.sample(status.index); }
+  // Monitor thread only; also frees the tables retired by rebuilds once their grace period has passed.
+  void compute_rates(int64_t time_diff_ms, int64_t now_ms);
+  // Indices whose rate moved in the last compute_rates call; monitor thread only.
+  const std::vector<uint32_t>& changed() const { return slab_.changed(); }
+
+  // Contention on the shard insert locks, which registration and removal take; lookups never do.
+  FpsHistogramSnapshot lock_wait() const { return lock_wait_.snapshot(); }
+  FpsHistogramSnapshot lock_hold() const { return lock_hold_.snapshot(); }
+  uint64_t             registrations() const { return registrations_.load(std::memory_order_relaxed); }
+  uint64_t             unregistrations() const { return unregistrations_.load(std::memory_order_relaxed); }
+
+  // Visits registered channels only; cells that were unregistered and not yet reused are skipped.
+  template <typename Fn> void for_each(Fn&& fn) const {
+    const size_t count = size();
+    for (size_t i = 0; i < count; i++) {
+      FpsStatus& status = at(i);
+      if (status.is_live()) {
+        fn(status);
+      }
+    }
+  }
+};
+
+#endif // fps_registry_h
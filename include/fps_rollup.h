@@ -0,0 +1,94 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#pragma once
+#ifndef fps_rollup_h
+#define fps_rollup_h
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <fps_health.h>
+#include <fps_registry.h>
+#include <fpsutil_export.h>
+
+// Stands for "every app" or "every channel" in the key of an aggregate node.
+constexpr uint64_t FPS_ROLLUP_ALL = UINT64_MAX;
+
+struct FpsRollupNode {
+  uint64_t                app_id{FPS_ROLLUP_ALL};
+  uint64_t                channel_id{FPS_ROLLUP_ALL};
+  float                   fps{0.0};
+  uint32_t                channels{0}; // registered (app, channel, thread) entries below the node
+  std::array<uint32_t, 4> health{};    // channel count per FpsHealthState
+
+  uint32_t count(FpsHealthState state) const { return health[static_cast<size_t>(state)]; }
+};
+
+// Aggregates kept per (app, channel) over all thread ids, per app and for the whole process. Every entry remembers what
+// it last contributed, so a pass only touches the nodes of entries whose rate, health or registration changed.
+// Membership and every rate are only re-read from the registry when its layout version moved; otherwise a pass applies
+// just the cells the sampling pass reported as changed.
+class FPSUTIL_EXPORT FpsRollup {
+private:
+  static constexpr uint32_t TOTAL_NODE = 0;
+
+  struct Node {
+    FpsRollupNode         value;
+    double                fps{0.0}; // summed in double so repeated deltas do not drift
+    std::vector<uint32_t> children;
+  };
+
+  struct Leaf {
+    bool           is_tracked{false};
+    uint32_t       generation{0};
+    FpsKey         key;
+    uint32_t       app_node{0};
+    uint32_t       channel_node{0};
+    FpsHealthState health{FpsHealthState::UNKNOWN};
+  };
+
+  mutable std::mutex                                mtx_;
+  std::vector<Node>                                 nodes_;
+  std::map<uint64_t, uint32_t>                      app_nodes_;
+  std::map<std::pair<uint64_t, uint64_t>, uint32_t> channel_nodes_;
+  // Owned by the monitor thread; fps_[i] is what leaves_[i] contributes, or the last rate seen while it is untracked.
+  std::vector<Leaf>  leaves_;
+  std::vector<float> fps_;
+  uint64_t           layout_version_{UINT64_MAX};
+
+  uint32_t app_node_(uint64_t app_id);
+  uint32_t channel_node_(uint64_t app_id, uint64_t channel_id);
+  void     add_(size_t index, bool is_added);
+  void     set_fps_(size_t index, float fps);
+  void     refresh_(size_t index, float fps);
+  void     set_health_(Leaf& leaf, FpsHealthState state);
+  void     track_(const FpsRegistry& registry, const FpsHealth& health, size_t count);
+
+public:
+  FpsRollup();
+
+  // Sampling pass: picks up registrations, removals and new rates.
+  void update(const FpsRegistry& registry, const FpsHealth& health);
+  // Health checks: applies the transitions found by the last check.
+  void apply(const FpsRegistry& registry, const std::vector<FpsHealthEvent>& transitions);
+
+  FpsRollupNode total() const;
+  // Zeroed nodes carrying the requested key when nothing is registered below them.
+  FpsRollupNode app(uint64_t app_id) const;
+  FpsRollupNode channel(uint64_t app_id, uint64_t channel_id) const;
+  // Every app node, and every channel node of one app, that still has channels, in key order.
+  std::vector<FpsRollupNode> apps() const;
+  std::vector<FpsRollupNode> channels(uint64_t app_id) const;
+  // Same, refilling out so a caller that asks on every pass reuses its buffer.
+  void                       apps(std::vector<FpsRollupNode>& out) const;
+  void                       channels(uint64_t app_id, std::vector<FpsRollupNode>& out) const;
+};
+
+#endif // fps_rollup_h
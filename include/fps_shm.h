@@ -0,0 +1,106 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#pragma once
+#ifndef fps_shm_h
+#define fps_shm_h
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <fps_snapshot.h>
+#include <fpsutil_export.h>
+
+// Layout of the shared-memory stats segment: an FpsShmHeader followed by `capacity` FpsShmEntry records.
+// The writer brackets every publish with the header's sequence number (odd while writing), so readers copy the
+// segment without locks or syscalls and retry if the sequence moved underneath them.
+constexpr uint32_t FPS_SHM_MAGIC   = 0x4d535046; // "FPSM"
+constexpr uint32_t FPS_SHM_VERSION = 1;
+
+struct FpsShmHeader {
+  std::atomic_uint32_t magic; // stored last, once the rest of the header is valid
+  uint32_t             version;
+  uint32_t             header_size;
+  uint32_t             entry_size;
+  uint64_t             capacity;
+  uint64_t             pid;
+  std::atomic_uint64_t sequence;
+  std::atomic_int64_t  ts;       // system clock milliseconds of the published sampling pass
+  std::atomic_uint64_t count;    // entries in use, at most capacity
+  std::atomic_uint64_t channels; // channels registered, may exceed capacity
+};
+
+struct FpsShmEntry {
+  std::atomic_uint64_t app_id;
+  std::atomic_uint64_t channel_id;
+  std::atomic_uint64_t thread_id;
+  std::atomic_uint64_t value;
+  std::atomic_uint32_t fps_bits;
+  std::atomic_uint32_t dump_in_log;
+};
+
+static_assert(std::atomic_uint64_t::is_always_lock_free && std::atomic_uint32_t::is_always_lock_free,
+              "the shared segment needs address-free atomics");
+
+// Maps a named segment that lives as long as the writer.
+class FPSUTIL_EXPORT FpsShmSegment {
+protected:
+  std::string   name_;
+  void*         data_{nullptr};
+  size_t        size_{0};
+  std::intptr_t handle_{-1};
+
+  FpsShmHeader* header_() const { return static_cast<FpsShmHeader*>(data_); }
+  FpsShmEntry*  entries_() const;
+  void          unmap_();
+
+public:
+  FpsShmSegment()                                = default;
+  ~FpsShmSegment()                               = default;
+  FpsShmSegment(const FpsShmSegment&)            = delete;
+  FpsShmSegment& operator=(const FpsShmSegment&) = delete;
+  FpsShmSegment(FpsShmSegment&&)                 = delete;
+  FpsShmSegment& operator=(FpsShmSegment&&)      = delete;
+
+  bool               is_open() const { return data_ != nullptr; }
+  const std::string& name() const { return name_; }
+};
+
+class FPSUTIL_EXPORT FpsShmWriter : public FpsShmSegment {
+public:
+  FpsShmWriter() = default;
+  ~FpsShmWriter() { close(); }
+  FpsShmWriter(const FpsShmWriter&)            = delete;
+  FpsShmWriter& operator=(const FpsShmWriter&) = delete;
+  FpsShmWriter(FpsShmWriter&&)                 = delete;
+  FpsShmWriter& operator=(FpsShmWriter&&)      = delete;
+
+  // Creates (or replaces) the segment with room for capacity channels.
+  bool open(const std::string& name, size_t capacity);
+  // Channels beyond capacity are counted in the header but not published.
+  void publish(const FpsSnapshot& snapshot);
+  void close();
+};
+
+class FPSUTIL_EXPORT FpsShmReader : public FpsShmSegment {
+public:
+  FpsShmReader() = default;
+  ~FpsShmReader() { detach(); }
+  FpsShmReader(const FpsShmReader&)            = delete;
+  FpsShmReader& operator=(const FpsShmReader&) = delete;
+  FpsShmReader(FpsShmReader&&)                 = delete;
+  FpsShmReader& operator=(FpsShmReader&&)      = delete;
+
+  // Fails if the segment does not exist or was written by an incompatible layout version.
+  bool attach(const std::string& name);
+  void detach();
+  // Copies a consistent snapshot; fails if the writer kept publishing for max_retries attempts.
+  bool     read(FpsSnapshot& snapshot, uint64_t* channels = nullptr, int max_retries = 64) const;
+  uint64_t pid() const { return header_()->pid; }
+  uint64_t sequence() const { return header_()->sequence.load(std::memory_order_acquire); }
+};
+
+#endif // fps_shm_h
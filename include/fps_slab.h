@@ -0,0 +1,183 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#pragma once
+#ifndef fps_slab_h
+#define fps_slab_h
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <fps_estimator.h>
+#include <fps_jitter.h>
+#include <fpsutil_export.h>
+
+struct FpsKey {
+  uint64_t app_id{0};
+  uint64_t channel_id{0};
+  uint64_t thread_id{0};
+
+  bool operator==(const FpsKey& other) const {
+    return app_id == other.app_id && channel_id == other.channel_id && thread_id == other.thread_id;
+  }
+  bool     operator!=(const FpsKey& other) const { return !(*this == other); }
+  uint64_t hash() const;
+};
+
+constexpr size_t FPS_CACHE_LINE_SIZE = 64;
+constexpr size_t FPS_MAX_STRIPES     = 64;
+constexpr size_t FPS_SEGMENT_SIZE    = 1024;
+// Sampling passes a retired cell or registry table is kept before it is reused or freed.
+constexpr uint64_t FPS_RECLAIM_PASSES = 2;
+
+struct alignas(FPS_CACHE_LINE_SIZE) FpsStripe {
+  std::atomic_uint_fast64_t value{0};
+};
+
+struct FpsStripeSet {
+  size_t                       mask;
+  std::unique_ptr<FpsStripe[]> lines; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+  explicit FpsStripeSet(size_t count);
+};
+
+// Key and flags share the first cache line and the producer counter owns the second, so decoders bumping one channel
+// never invalidate another channel's line. The monitor's per-channel bookkeeping lives in the slab's parallel arrays.
+// The generation sits next to the counter: it is even while the channel is registered and odd once it has been
+// unregistered, and every reuse of the cell moves it on, so handles can detect that their channel is gone.
+struct alignas(FPS_CACHE_LINE_SIZE) FpsStatus {
+  std::atomic_uint_fast64_t         app_id{0};
+  std::atomic_uint_fast64_t         channel_id{0};
+  std::atomic_uint_fast64_t         thread_id{0};
+  std::atomic_bool                  dump_in_log{false};
+  uint32_t                          index{0};
+  std::atomic<FpsStripeSet*>        stripes{nullptr};
+  std::unique_ptr<FpsStripeSet>     stripe_storage;
+  std::atomic<FpsRateEstimator*>    estimator{nullptr};
+  std::unique_ptr<FpsRateEstimator> estimator_storage;
+
+  alignas(FPS_CACHE_LINE_SIZE) std::atomic_uint_fast64_t value{0};
+  std::atomic_uint32_t       generation{0};
+  std::atomic<FpsJitter*>    jitter{nullptr};
+  std::unique_ptr<FpsJitter> jitter_storage;
+
+  FpsKey key() const { return FpsKey{app_id.load(), channel_id.load(), thread_id.load()}; }
+  bool   is_live() const { return (generation.load(std::memory_order_acquire) & 1U) == 0; }
+
+  // Counter the calling thread should tick: its own stripe once striping is enabled, the shared slot otherwise.
+  std::atomic_uint_fast64_t& counter();
+  uint64_t                   total() const;
+  bool                       enable_striping(size_t stripe_count);
+  // Attaches a rate estimator that the monitor feeds on every sampling pass. Like stripes, it stays with the cell.
+  bool                       enable_estimator(const FpsEstimatorConfig& config);
+  // Timing mode: every tick through the channel's entry points also records the gap since the previous tick.
+  bool                       enable_timing();
+  void                       record_arrival() {
+    if (FpsJitter* timing = jitter.load(std::memory_order_relaxed)) {
+      timing->record();
+    }
+  }
+};
+
+static_assert(sizeof(FpsStatus) == 2 * FPS_CACHE_LINE_SIZE, "FpsStatus is a key line and a counter line");
+
+// Generation-checked reference to a channel. Ticks are dropped once the channel is unregistered, even if its cell has
+// since been handed to another channel.
+struct FpsHandle {
+  FpsStatus* status{nullptr};
+  uint32_t   generation{0};
+
+  bool valid() const { return status != nullptr && status->generation.load(std::memory_order_relaxed) == generation; }
+  bool tick(uint64_t count = 1) const {
+    if (!valid()) {
+      return false;
+    }
+    status->counter().fetch_add(count, std::memory_order_relaxed);
+    status->record_arrival();
+    return true;
+  }
+};
+
+// One block of FPS_SEGMENT_SIZE channels. Counters stay in padded FpsStatus cells, while the per-interval sample,
+// previous value and rate are kept as parallel arrays so the monitor pass is a linear, vectorisable loop.
+struct FpsSegment {
+  std::array<FpsStatus, FPS_SEGMENT_SIZE>                                       status;
+  alignas(FPS_CACHE_LINE_SIZE) std::array<uint64_t, FPS_SEGMENT_SIZE>           sample{};
+  alignas(FPS_CACHE_LINE_SIZE) std::array<uint64_t, FPS_SEGMENT_SIZE>           last_value{};
+  alignas(FPS_CACHE_LINE_SIZE) std::array<float, FPS_SEGMENT_SIZE>              rate{};
+  alignas(FPS_CACHE_LINE_SIZE) std::array<std::atomic<float>, FPS_SEGMENT_SIZE> last_fps{};
+  alignas(FPS_CACHE_LINE_SIZE) std::array<int64_t, FPS_SEGMENT_SIZE>            last_change{};
+};
+
+// Arena of channels with stable indices. Appends serialise on a mutex; readers index without locking.
+// Retired cells are recycled only after FPS_RECLAIM_PASSES further sampling passes, which is the grace period for a tick
+// that passed its generation check just before the retire. The bound is on preemption, not enforced: a producer that
+// stalls for that many sampling intervals between its check and its increment adds that one tick to the cell's next
+// owner. The counters stay valid memory either way. The sampling pass clears cells before they are handed out again,
+// so appends never touch the per-interval arrays it owns.
+class FPSUTIL_EXPORT FpsSlab {
+private:
+  static constexpr size_t MAX_SEGMENTS = 4096;
+
+  struct Retired {
+    uint32_t index;
+    uint64_t pass;
+  };
+
+  std::mutex                                          append_mtx_;
+  std::atomic_size_t                                  size_{0};
+  std::atomic_size_t                                  live_{0};
+  std::atomic_uint64_t                                layout_version_{0};
+  std::array<std::atomic<FpsSegment*>, MAX_SEGMENTS> segments_{};
+  std::vector<std::unique_ptr<FpsSegment>>            storage_;
+  std::atomic_uint64_t                                pass_{0};
+  std::atomic_size_t                                  retired_count_{0};
+  std::vector<Retired>                                retired_;
+  std::vector<uint32_t>                               free_;
+  std::vector<uint32_t>                               changed_; // monitor thread only
+
+  void reclaim_();
+  void clear_(size_t index); // monitor thread only, like the per-interval arrays it resets
+  void allocate_(size_t segment);
+
+  FpsSegment& segment_(size_t index) const {
+    return *segments_[index / FPS_SEGMENT_SIZE].load(std::memory_order_acquire);
+  }
+
+public:
+  FpsSlab()                          = default;
+  ~FpsSlab()                         = default;
+  FpsSlab(const FpsSlab&)            = delete;
+  FpsSlab& operator=(const FpsSlab&) = delete;
+  FpsSlab(FpsSlab&&)                 = delete;
+  FpsSlab& operator=(FpsSlab&&)      = delete;
+
+  FpsStatus& append(const FpsKey& key, bool dump_in_log);
+  void       retire(FpsStatus& status);
+  // Allocates the segments for count more channels up front, so appends that follow never allocate.
+  void       reserve(size_t count);
+  size_t     size() const { return size_.load(std::memory_order_acquire); }
+  size_t     live() const { return live_.load(std::memory_order_relaxed); }
+  // Moves on whenever a channel is registered or unregistered, after the cell and size reflect the change.
+  uint64_t   layout_version() const { return layout_version_.load(std::memory_order_acquire); }
+  // Sampling passes completed so far.
+  uint64_t   passes() const { return pass_.load(std::memory_order_relaxed); }
+
+  FpsStatus& status(size_t index) const { return segment_(index).status[index % FPS_SEGMENT_SIZE]; }
+  std::atomic<float>& last_fps(size_t index) const { return segment_(index).last_fps[index % FPS_SEGMENT_SIZE]; }
+  uint64_t            sample(size_t index) const { return segment_(index).sample[index % FPS_SEGMENT_SIZE]; }
+  int64_t last_change(size_t index) const { return segment_(index).last_change[index % FPS_SEGMENT_SIZE]; }
+
+  // Samples every counter, turns the delta since the previous call into a rate and publishes it to last_fps.
+  // last_change records now_ms for every channel that ticked. Also recycles cells whose grace period has passed.
+  void compute_rates(int64_t time_diff_ms, int64_t now_ms);
+  // Cells whose published rate moved in the last compute_rates call, in index order; monitor thread only.
+  const std::vector<uint32_t>& changed() const { return changed_; }
+};
+
+#endif // fps_slab_h
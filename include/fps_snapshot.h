@@ -0,0 +1,32 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#pragma once
+#ifndef fps_snapshot_h
+#define fps_snapshot_h
+
+#include <cstdint>
+#include <vector>
+
+#include <fps_jitter.h>
+#include <fps_latency.h>
+#include <fps_slab.h>
+
+struct FpsSample {
+  FpsKey         key;
+  uint64_t       value{0};
+  float          fps{0.0};
+  bool           dump_in_log{false};
+  bool           is_timed{false};
+  FpsJitterStats jitter; // inter-arrival gaps since the previous log pass, for timed channels
+};
+
+// Plain copy of every channel taken right after a sampling pass, so formatting and exporting never touch the registry.
+struct FpsSnapshot {
+  int64_t                      ts{0};
+  std::vector<FpsSample>       samples;
+  std::vector<FpsLatencyStats> latencies; // traced channels with at least two stages
+};
+
+#endif // fps_snapshot_h
@@ -0,0 +1,100 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#pragma once
+#ifndef fps_stats_h
+#define fps_stats_h
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include <fpsutil_export.h>
+
+constexpr size_t FPS_HISTOGRAM_BUCKETS = 40;
+
+// Plain copy of an FpsHistogram. Bucket i counts durations in [2^(i-1), 2^i) nanoseconds, bucket 0 counts zero.
+struct FPSUTIL_EXPORT FpsHistogramSnapshot {
+  std::array<uint64_t, FPS_HISTOGRAM_BUCKETS> buckets{};
+  uint64_t                                    count{0};
+  uint64_t                                    total_ns{0};
+  uint64_t                                    max_ns{0};
+
+  uint64_t mean_ns() const { return count != 0 ? total_ns / count : 0; }
+  // Upper bound of the bucket holding the q-th quantile, clamped to max_ns.
+  uint64_t quantile_ns(double q) const;
+};
+
+// Lock-free log2 histogram of durations in nanoseconds.
+class FPSUTIL_EXPORT FpsHistogram {
+private:
+  std::array<std::atomic_uint64_t, FPS_HISTOGRAM_BUCKETS> buckets_{};
+  std::atomic_uint64_t                                    count_{0};
+  std::atomic_uint64_t                                    total_ns_{0};
+  std::atomic_uint64_t                                    max_ns_{0};
+
+public:
+  void                 record(uint64_t ns);
+  void                 record(std::chrono::steady_clock::duration duration);
+  FpsHistogramSnapshot snapshot() const;
+};
+
+struct FpsSinkStats {
+  std::atomic_uint64_t bytes{0};
+  std::atomic_uint64_t lines{0};
+
+  void add(size_t size) {
+    bytes.fetch_add(size + 1, std::memory_order_relaxed); // plus the newline
+    lines.fetch_add(1, std::memory_order_relaxed);
+  }
+};
+
+// Locks a mutex and records how long the caller waited for it and, on destruction, how long it was held.
+class FpsTimedLock {
+private:
+  std::unique_lock<std::mutex>          lock_;
+  FpsHistogram&                         hold_;
+  std::chrono::steady_clock::time_point acquired_;
+
+public:
+  FpsTimedLock(std::mutex& mtx, FpsHistogram& wait, FpsHistogram& hold) : lock_(mtx, std::defer_lock), hold_(hold) {
+    const auto start = std::chrono::steady_clock::now();
+    lock_.lock();
+    acquired_ = std::chrono::steady_clock::now();
+    wait.record(acquired_ - start);
+  }
+  ~FpsTimedLock() {
+    const auto held = std::chrono::steady_clock::now() - acquired_;
+    lock_.unlock();
+    hold_.record(held);
+  }
+  FpsTimedLock(const FpsTimedLock&)            = delete;
+  FpsTimedLock& operator=(const FpsTimedLock&) = delete;
+  FpsTimedLock(FpsTimedLock&&)                 = delete;
+  FpsTimedLock& operator=(FpsTimedLock&&)      = delete;
+};
+
+// What the monitor costs: registry lock contention, pass durations and log volume.
+struct FpsSelfStats {
+  FpsHistogramSnapshot lock_wait;
+  FpsHistogramSnapshot lock_hold;
+  FpsHistogramSnapshot sample_pass;
+  FpsHistogramSnapshot log_pass;
+  uint64_t             log_bytes{0};
+  uint64_t             log_lines{0};
+  uint64_t             summary_bytes{0};
+  uint64_t             summary_lines{0};
+  size_t               channels{0};
+  uint64_t             registrations{0};
+  uint64_t             unregistrations{0};
+  // Registrations per second over the last sampling pass.
+  float registration_rate{0.0};
+  // Per-thread tick buffers replaced because a thread batched into more monitors than it keeps buffers for.
+  uint64_t batch_evictions{0};
+};
+
+#endif // fps_stats_h
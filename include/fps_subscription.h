@@ -0,0 +1,95 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#pragma once
+#ifndef fps_subscription_h
+#define fps_subscription_h
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include <fps_slab.h>
+#include <fps_snapshot.h>
+#include <fpsutil_export.h>
+
+using FpsSnapshotPtr = std::shared_ptr<const FpsSnapshot>;
+
+// Bounded lock-free queue of snapshots (Vyukov's sequence-per-cell design). Any thread may push or pop, which is what
+// lets the producer discard the oldest entry of a full queue while the consumer is popping.
+class FPSUTIL_EXPORT FpsSnapshotRing {
+private:
+  struct Cell {
+    std::atomic_size_t sequence{0};
+    FpsSnapshotPtr     snapshot;
+  };
+
+  size_t                  mask_;
+  std::unique_ptr<Cell[]> cells_; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+  alignas(FPS_CACHE_LINE_SIZE) std::atomic_size_t head_{0};
+  alignas(FPS_CACHE_LINE_SIZE) std::atomic_size_t tail_{0};
+
+public:
+  // The capacity is rounded up to a power of two.
+  explicit FpsSnapshotRing(size_t capacity);
+
+  bool           push(FpsSnapshotPtr snapshot);
+  FpsSnapshotPtr pop();
+  bool           is_empty() const {
+    return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+  }
+};
+
+enum class FpsBackpressure : uint8_t {
+  DROP_OLDEST, // a full queue discards its oldest snapshot; the consumer always sees the latest ones
+  DROP_NEWEST, // a full queue discards the new snapshot
+  BLOCK,       // the monitor waits for room, up to block_timeout (zero waits indefinitely)
+};
+
+struct FpsSubscriptionConfig {
+  size_t          capacity{16};
+  FpsBackpressure backpressure{FpsBackpressure::DROP_OLDEST};
+  // BLOCK stalls the monitor's sampling, and with it every other monitor of the group thread, for this long at most.
+  std::chrono::milliseconds block_timeout{1000};
+};
+
+// Stream of the snapshots taken by one monitor, one per sampling pass. Snapshots are shared and immutable, so a
+// consumer never touches the registry. Consumers poll or wait from one thread; the monitor pushes from its own.
+class FPSUTIL_EXPORT FpsSubscription {
+private:
+  FpsSubscriptionConfig config_;
+  FpsSnapshotRing       ring_;
+  std::atomic_uint64_t  delivered_{0};
+  std::atomic_uint64_t  dropped_{0};
+  std::atomic_bool      is_closed_{false};
+
+  // Sleeping only happens on the slow paths; the flags keep the fast paths free of the mutex.
+  std::mutex              mtx_;
+  std::condition_variable cv_;
+  std::atomic_int         waiting_consumers_{0};
+  std::atomic_int         waiting_producers_{0};
+
+  void notify_(const std::atomic_int& waiting);
+
+public:
+  explicit FpsSubscription(const FpsSubscriptionConfig& config);
+
+  // Called by the monitor after each sampling pass; false when the snapshot was dropped.
+  bool publish(const FpsSnapshotPtr& snapshot);
+  // Next snapshot, or nullptr when none is queued.
+  FpsSnapshotPtr poll();
+  // Next snapshot, waiting up to timeout; nullptr on timeout or once the subscription is closed and drained.
+  FpsSnapshotPtr wait(std::chrono::milliseconds timeout);
+  // Stops the stream; the monitor forgets closed subscriptions on its next pass.
+  void           close();
+  bool           is_closed() const { return is_closed_.load(std::memory_order_acquire); }
+  uint64_t       delivered() const { return delivered_.load(std::memory_order_relaxed); }
+  uint64_t       dropped() const { return dropped_.load(std::memory_order_relaxed); }
+};
+
+#endif // fps_subscription_h
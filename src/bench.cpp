@@ -0,0 +1,285 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#include "fps_counter.h"
+#include "fps_monitor.h"
+#include "fps_monitor_c.h"
+#include "fps_monitor_group.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fmt/core.h>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Microbenchmarks for the counting, registry and logging paths. Every result is printed as one JSON object per line:
+//   {"bench":"...","threads":N,"channels":N,"ops":N,"ns_per_op":X}
+// Usage: bench [session_dir] [scale]. scale multiplies the iteration counts, default 1.
+
+namespace {
+using bench_clock         = std::chrono::steady_clock;
+using MultiWriterCounter  = FpsBasicCounter<FpsWindow<10000>, FpsChronoClock<>, FpsMultiWriter>;
+using SingleThreadCounter = FpsBasicCounter<FpsWindow<10000>, FpsChronoClock<>, FpsSingleThreaded>;
+
+constexpr std::array<int, 7>      THREAD_COUNTS{1, 2, 4, 8, 16, 32, 64};
+constexpr std::array<uint64_t, 5> CHANNEL_COUNTS{10, 100, 1000, 10000, 100000};
+constexpr uint64_t                TICK_OPS       = 2000000;
+constexpr uint64_t                LOOKUP_OPS     = 1000000;
+constexpr uint64_t                COUNTER_OPS    = 5000000;
+constexpr int                     WRITE_PASSES   = 5;
+constexpr uint64_t                BENCH_APP_ID   = 7;
+constexpr uint64_t                LOOKUP_KEYS    = 1024;
+constexpr size_t                  BATCH_SIZE     = 32;
+constexpr uint64_t                BATCH_CHANNELS = 16;
+
+void report(const char* bench, int threads, uint64_t channels, uint64_t ops, bench_clock::duration elapsed) {
+  const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+  fmt::print("{{\"bench\":\"{}\",\"threads\":{},\"channels\":{},\"ops\":{},\"ns_per_op\":{:.2f}}}\n", bench, threads,
+             channels, ops, ops != 0 ? ns / static_cast<double>(ops) : 0.0);
+  std::fflush(stdout);
+}
+
+// Runs fn(thread_index, ops_per_thread) on `threads` threads released together and returns the wall time.
+bench_clock::duration run_threads(int threads, uint64_t ops_per_thread,
+                                  const std::function<void(int, uint64_t)>& fn) {
+  std::atomic_bool         go{false};
+  std::vector<std::thread> workers;
+  workers.reserve(threads);
+  for (int i = 0; i < threads; i++) {
+    workers.emplace_back([&, i] {
+      while (!go.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+      fn(i, ops_per_thread);
+    });
+  }
+  const auto start = bench_clock::now();
+  go.store(true, std::memory_order_release);
+  for (auto&& worker : workers) {
+    worker.join();
+  }
+  return bench_clock::now() - start;
+}
+
+void bench_set_status(uint64_t scale) {
+  for (int threads : THREAD_COUNTS) {
+    const uint64_t per_thread = TICK_OPS * scale / threads;
+    // Every thread feeds its own channel, then all threads feed one shared channel.
+    auto elapsed = run_threads(threads, per_thread, [](int index, uint64_t ops) {
+      for (uint64_t i = 0; i < ops; i++) {
+        FpsMonitor::set_status(BENCH_APP_ID, 1, index);
+      }
+    });
+    report("monitor_set_status_own_channel", threads, threads, per_thread * threads, elapsed);
+
+    elapsed = run_threads(threads, per_thread, [](int /*index*/, uint64_t ops) {
+      for (uint64_t i = 0; i < ops; i++) {
+        FpsMonitor::set_status(BENCH_APP_ID, 2, 0);
+      }
+    });
+    report("monitor_set_status_shared_channel", threads, 1, per_thread * threads, elapsed);
+
+    elapsed = run_threads(threads, per_thread, [](int index, uint64_t ops) {
+      for (uint64_t i = 0; i < ops; i++) {
+        set_status(BENCH_APP_ID, 3, index);
+      }
+    });
+    report("c_set_status_own_channel", threads, threads, per_thread * threads, elapsed);
+
+    elapsed = run_threads(threads, per_thread, [](int index, uint64_t ops) {
+      const fps_handle_t handle = fps_acquire(BENCH_APP_ID, 4, index);
+      for (uint64_t i = 0; i < ops; i++) {
+        fps_tick(handle, 1);
+      }
+    });
+    report("c_fps_tick_own_channel", threads, threads, per_thread * threads, elapsed);
+
+    elapsed = run_threads(threads, per_thread, [](int /*index*/, uint64_t ops) {
+      const fps_handle_t handle = fps_acquire(BENCH_APP_ID, 5, 0);
+      for (uint64_t i = 0; i < ops; i++) {
+        fps_tick(handle, 1);
+      }
+    });
+    report("c_fps_tick_shared_channel", threads, 1, per_thread * threads, elapsed);
+  }
+}
+
+// A stage handling batches of BATCH_SIZE frames from BATCH_CHANNELS channels shared by all threads, ticked per frame
+// and then as one batch.
+void bench_tick_batch(uint64_t scale) {
+  for (int threads : THREAD_COUNTS) {
+    const uint64_t per_thread = TICK_OPS * scale / threads / BATCH_SIZE * BATCH_SIZE;
+    auto           elapsed    = run_threads(threads, per_thread, [](int /*index*/, uint64_t ops) {
+      for (uint64_t i = 0; i < ops; i++) {
+        FpsMonitor::set_status(BENCH_APP_ID, 200 + (i % BATCH_CHANNELS), 0);
+      }
+    });
+    report("monitor_set_status_per_frame", threads, BATCH_CHANNELS, per_thread * threads, elapsed);
+
+    elapsed = run_threads(threads, per_thread, [](int /*index*/, uint64_t ops) {
+      std::array<FpsKeyTick, BATCH_SIZE> batch;
+      for (uint64_t i = 0; i < ops; i += BATCH_SIZE) {
+        for (size_t j = 0; j < BATCH_SIZE; j++) {
+          batch[j] = FpsKeyTick{FpsKey{BENCH_APP_ID, 200 + (j % BATCH_CHANNELS), 0}, 1};
+        }
+        FpsMonitor::tick_batch(batch.data(), batch.size());
+      }
+    });
+    report("monitor_tick_batch_keys", threads, BATCH_CHANNELS, per_thread * threads, elapsed);
+
+    elapsed = run_threads(threads, per_thread, [](int /*index*/, uint64_t ops) {
+      std::array<FpsTick, BATCH_SIZE> batch;
+      for (size_t j = 0; j < BATCH_SIZE; j++) {
+        batch[j] = FpsTick{FpsMonitor::get_handle(BENCH_APP_ID, 200 + (j % BATCH_CHANNELS), 0), 1};
+      }
+      for (uint64_t i = 0; i < ops; i += BATCH_SIZE) {
+        FpsMonitor::tick_batch(batch.data(), batch.size());
+      }
+    });
+    report("monitor_tick_batch_handles", threads, BATCH_CHANNELS, per_thread * threads, elapsed);
+  }
+}
+
+// Every thread is one stage of a traced channel and marks the same frame ids, as a decode/infer/encode pipeline would.
+void bench_trace_mark(uint64_t scale) {
+  for (int threads : THREAD_COUNTS) {
+    if (static_cast<size_t>(threads) > FPS_MAX_STAGES) {
+      break;
+    }
+    const uint64_t per_thread = TICK_OPS * scale / threads;
+    const uint64_t channel    = 300 + threads;
+    FpsMonitor::enable_tracing(BENCH_APP_ID, channel, {});
+    auto elapsed = run_threads(threads, per_thread, [channel](int index, uint64_t ops) {
+      const FpsTraceHandle handle = FpsMonitor::get_trace_handle(BENCH_APP_ID, channel, index);
+      for (uint64_t i = 0; i < ops; i++) {
+        handle.mark(i);
+      }
+    });
+    report("trace_mark_handle", threads, 1, per_thread * threads, elapsed);
+
+    elapsed = run_threads(threads, per_thread, [channel](int index, uint64_t ops) {
+      for (uint64_t i = 0; i < ops; i++) {
+        FpsMonitor::mark_frame(BENCH_APP_ID, channel, index, i);
+      }
+    });
+    report("monitor_mark_frame", threads, 1, per_thread * threads, elapsed);
+  }
+}
+
+void bench_get_fps(uint64_t scale) {
+  for (uint64_t key = 0; key < LOOKUP_KEYS; key++) {
+    FpsMonitor::set_status(BENCH_APP_ID, 100 + key, 0);
+  }
+  const uint64_t ops   = LOOKUP_OPS * scale;
+  float          sink  = 0;
+  const auto     start = bench_clock::now();
+  for (uint64_t i = 0; i < ops; i++) {
+    sink += FpsMonitor::get_fps(BENCH_APP_ID, 100 + (i % LOOKUP_KEYS), 0).load(std::memory_order_relaxed);
+  }
+  report("monitor_get_fps", 1, LOOKUP_KEYS, ops, bench_clock::now() - start);
+  if (sink < 0) {
+    fmt::print(stderr, "{}\n", sink);
+  }
+}
+
+template <class Counter> void bench_fps_counter(const std::string& name, uint64_t scale) {
+  Counter        counter;
+  const uint64_t ops   = COUNTER_OPS * scale;
+  auto           start = bench_clock::now();
+  for (uint64_t i = 0; i < ops; i++) {
+    counter.set_status(1);
+  }
+  report((name + "_set_status").c_str(), 1, 1, ops, bench_clock::now() - start);
+
+  float sink = 0;
+  start      = bench_clock::now();
+  for (uint64_t i = 0; i < ops; i++) {
+    sink += counter.get_fps_at(static_cast<int64_t>(i));
+  }
+  report((name + "_get_fps").c_str(), 1, 1, ops, bench_clock::now() - start);
+  if (sink < 0) {
+    fmt::print(stderr, "{}\n", sink);
+  }
+}
+
+// Boot-time registration of every channel on a fresh monitor, one key at a time and in a single bulk call.
+void bench_register(const std::string& session_dir) {
+  FpsMonitorConfig config;
+  config.manual = true;
+  for (uint64_t channels : CHANNEL_COUNTS) {
+    std::vector<FpsKey> keys;
+    keys.reserve(channels);
+    for (uint64_t channel = 0; channel < channels; channel++) {
+      keys.push_back(FpsKey{BENCH_APP_ID, channel, 0});
+    }
+    FpsMonitor& single = FpsMonitorGroup::getInstance().create(fmt::format("register_{}", channels), session_dir,
+                                                               fmt::format("register_{}", channels), config);
+    auto        start  = bench_clock::now();
+    for (const FpsKey& key : keys) {
+      single.handle(key.app_id, key.channel_id, key.thread_id);
+    }
+    report("monitor_register", 1, channels, channels, bench_clock::now() - start);
+
+    FpsMonitor& bulk = FpsMonitorGroup::getInstance().create(fmt::format("register_bulk_{}", channels), session_dir,
+                                                             fmt::format("register_bulk_{}", channels), config);
+    start            = bench_clock::now();
+    bulk.handles(keys);
+    report("monitor_register_bulk", 1, channels, channels, bench_clock::now() - start);
+  }
+}
+
+void bench_write_data(const std::string& session_dir) {
+  FpsMonitorConfig config;
+  config.manual = true;
+  for (uint64_t channels : CHANNEL_COUNTS) {
+    FpsMonitor& monitor = FpsMonitorGroup::getInstance().create(fmt::format("bench_{}", channels), session_dir,
+                                                                fmt::format("bench_{}", channels), config);
+    for (uint64_t channel = 0; channel < channels; channel++) {
+      monitor.status(BENCH_APP_ID, channel, 0);
+    }
+    // The first pass opens the log files and writes the header.
+    monitor.step(true);
+
+    auto sample = bench_clock::duration::zero();
+    auto log    = bench_clock::duration::zero();
+    for (int pass = 0; pass < WRITE_PASSES; pass++) {
+      for (uint64_t channel = 0; channel < channels; channel++) {
+        monitor.counter(BENCH_APP_ID, channel, 0).fetch_add(channel, std::memory_order_relaxed);
+      }
+      auto start = bench_clock::now();
+      monitor.step(false);
+      sample += bench_clock::now() - start;
+      start = bench_clock::now();
+      monitor.step(true);
+      log += bench_clock::now() - start;
+    }
+    report("monitor_sample_pass", 1, channels, WRITE_PASSES, sample);
+    report("monitor_sample_and_write_pass", 1, channels, WRITE_PASSES, log);
+    monitor.shutdown();
+  }
+}
+} // namespace
+
+auto main(int argc, char const* argv[]) -> int {
+  const std::vector<std::string> args(argv, argv + argc);
+  const std::string              session_dir = args.size() > 1 ? args[1] : "bench_session";
+  const uint64_t                 scale       = args.size() > 2 ? std::stoull(args[2]) : 1;
+
+  FpsMonitor::getInstance(session_dir, "fps_bench");
+  bench_set_status(scale);
+  bench_tick_batch(scale);
+  bench_trace_mark(scale);
+  bench_get_fps(scale);
+  bench_fps_counter<FpsCounter>("fps_counter", scale);
+  bench_fps_counter<MultiWriterCounter>("fps_counter_multi_writer", scale);
+  bench_fps_counter<SingleThreadCounter>("fps_counter_single_thread", scale);
+  bench_register(session_dir);
+  bench_write_data(session_dir);
+  FpsMonitor::close();
+  return 0;
+}
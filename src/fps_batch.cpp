@@ -0,0 +1,100 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#include "fps_batch.h"
+
+#include <algorithm>
+
+namespace {
+constexpr size_t TLS_BUFFER_SLOTS = 8;
+
+struct TlsBufferEntry {
+  uint64_t                       serial{0};
+  uint64_t                       last_use{0};
+  std::shared_ptr<FpsTickBuffer> buffer;
+};
+struct TlsBuffers {
+  std::array<TlsBufferEntry, TLS_BUFFER_SLOTS> entries;
+  uint64_t                                     uses{0};
+};
+// Buffers of the last few monitors this thread ticked through, fully associative with least recently used
+// replacement; serials are never reused, unlike monitor addresses.
+thread_local TlsBuffers tls_buffers;
+
+std::atomic_uint64_t next_serial{1};
+} // namespace
+
+void FpsTickBuffer::apply_(Slot& slot) {
+  if (slot.status != nullptr && slot.status->generation.load(std::memory_order_relaxed) == slot.generation) {
+    slot.status->counter().fetch_add(slot.count, std::memory_order_relaxed);
+  }
+  slot = Slot{};
+}
+
+size_t FpsTickBuffer::add(const FpsTick* ticks, size_t count) {
+  size_t                            accepted = 0;
+  const std::lock_guard<std::mutex> lock(mtx_);
+  for (size_t i = 0; i < count; i++) {
+    const FpsTick& tick = ticks[i]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if (!tick.handle.valid()) {
+      continue;
+    }
+    FpsStatus* status = tick.handle.status;
+    Slot&      slot   = slots_[status->index % SLOTS];
+    if (slot.status != status || slot.generation != tick.handle.generation) {
+      apply_(slot);
+      slot.status     = status;
+      slot.generation = tick.handle.generation;
+    }
+    slot.count += tick.count;
+    status->record_arrival();
+    accepted++;
+  }
+  return accepted;
+}
+
+void FpsTickBuffer::flush() {
+  const std::lock_guard<std::mutex> lock(mtx_);
+  for (Slot& slot : slots_) {
+    if (slot.status != nullptr) {
+      apply_(slot);
+    }
+  }
+}
+
+FpsTickBuffers::FpsTickBuffers() : serial_(next_serial.fetch_add(1, std::memory_order_relaxed)) {}
+
+FpsTickBuffer& FpsTickBuffers::local() {
+  const uint64_t  use    = ++tls_buffers.uses;
+  TlsBufferEntry* oldest = &tls_buffers.entries[0];
+  for (TlsBufferEntry& entry : tls_buffers.entries) {
+    if (entry.serial == serial_) {
+      entry.last_use = use;
+      return *entry.buffer;
+    }
+    if (entry.last_use < oldest->last_use) {
+      oldest = &entry;
+    }
+  }
+  // The evicted monitor keeps the buffer in its own list until its next flush applies it.
+  if (oldest->serial != 0) {
+    evictions_.fetch_add(1, std::memory_order_relaxed);
+  }
+  auto                              buffer = std::make_shared<FpsTickBuffer>();
+  const std::lock_guard<std::mutex> lock(mtx_);
+  buffers_.push_back(buffer);
+  *oldest = TlsBufferEntry{serial_, use, std::move(buffer)};
+  return *oldest->buffer;
+}
+
+void FpsTickBuffers::flush() {
+  const std::lock_guard<std::mutex> lock(mtx_);
+  for (const auto& buffer : buffers_) {
+    buffer->flush();
+  }
+  // Only this list still holds buffers whose thread has exited or moved the slot to another monitor.
+  buffers_.erase(std::remove_if(buffers_.begin(), buffers_.end(),
+                                [](const std::shared_ptr<FpsTickBuffer>& buffer) { return buffer.use_count() == 1; }),
+                 buffers_.end());
+}
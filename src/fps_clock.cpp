@@ -0,0 +1,118 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#include "fps_clock.h"
+
+#include <array>
+#include <chrono>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define FPS_HAS_TSC 1
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define FPS_HAS_TSC 1
+#endif
+#if defined(__linux__)
+#include <time.h>
+#endif
+
+namespace {
+constexpr auto     TSC_CALIBRATION  = std::chrono::milliseconds(10);
+constexpr uint32_t CPUID_EXTENDED   = 0x80000000; // reports the highest extended leaf
+constexpr uint32_t CPUID_POWER_MGMT = 0x80000007; // advanced power management leaf
+constexpr uint32_t INVARIANT_TSC    = 1U << 8U;   // EDX bit: the TSC rate ignores P-, C- and T-state changes
+
+int64_t steady_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+uint64_t read_tsc() {
+#if defined(FPS_HAS_TSC)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+bool has_invariant_tsc() {
+#if defined(FPS_HAS_TSC) && (defined(__x86_64__) || defined(__i386__))
+  unsigned eax = 0;
+  unsigned ebx = 0;
+  unsigned ecx = 0;
+  unsigned edx = 0;
+  // __get_cpuid checks the highest extended leaf first and fails on parts without this one.
+  return __get_cpuid(CPUID_POWER_MGMT, &eax, &ebx, &ecx, &edx) != 0 && (edx & INVARIANT_TSC) != 0;
+#elif defined(FPS_HAS_TSC)
+  std::array<int, 4> regs{};
+  __cpuid(regs.data(), static_cast<int>(CPUID_EXTENDED));
+  if (static_cast<uint32_t>(regs[0]) < CPUID_POWER_MGMT) {
+    return false;
+  }
+  __cpuid(regs.data(), static_cast<int>(CPUID_POWER_MGMT));
+  return (static_cast<uint32_t>(regs[3]) & INVARIANT_TSC) != 0;
+#else
+  return false;
+#endif
+}
+
+const FpsSteadyClock steady_clock_instance;
+} // namespace
+
+std::atomic<const FpsClock*> FpsClock::tick_clock_{&steady_clock_instance};
+
+int64_t FpsClock::wall_ms() const {
+  return std::chrono::time_point_cast<std::chrono::milliseconds>(std::chrono::system_clock::now())
+      .time_since_epoch()
+      .count();
+}
+
+const FpsClock& FpsClock::steady() { return steady_clock_instance; }
+
+void FpsClock::set_tick_clock(const FpsClock* clock) {
+  tick_clock_.store(clock != nullptr ? clock : &steady_clock_instance, std::memory_order_release);
+}
+
+int64_t FpsSteadyClock::now_ns() const { return steady_ns(); }
+
+int64_t FpsCoarseClock::now_ns() const {
+#if defined(__linux__) && defined(CLOCK_MONOTONIC_COARSE)
+  timespec ts{};
+  clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec; // NOLINT(readability-magic-numbers)
+#else
+  return steady_ns();
+#endif
+}
+
+FpsTscClock::FpsTscClock() {
+  if (!is_supported()) {
+    return;
+  }
+  const int64_t  start_ns    = steady_ns();
+  const uint64_t start_ticks = read_tsc();
+  std::this_thread::sleep_for(TSC_CALIBRATION);
+  const int64_t  end_ns    = steady_ns();
+  const uint64_t end_ticks = read_tsc();
+  if (end_ticks > start_ticks) {
+    ns_per_tick_ = static_cast<double>(end_ns - start_ns) / static_cast<double>(end_ticks - start_ticks);
+  }
+  base_ticks_ = end_ticks;
+  base_ns_    = end_ns;
+}
+
+int64_t FpsTscClock::now_ns() const {
+  if (!is_supported()) {
+    return steady_ns();
+  }
+  return base_ns_ + static_cast<int64_t>(static_cast<double>(read_tsc() - base_ticks_) * ns_per_tick_);
+}
+
+bool FpsTscClock::is_supported() {
+  static const bool is_invariant = has_invariant_tsc();
+  return is_invariant;
+}
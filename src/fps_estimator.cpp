@@ -0,0 +1,186 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#include "fps_estimator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr float MILLI_SECONDS_IN_SECONDS = 1000.0F;
+constexpr float P50                      = 0.5F;
+constexpr float P99                      = 0.99F;
+} // namespace
+
+size_t FpsRateHistogram::index_(float fps) {
+  if (!(fps >= 1.0F)) {
+    return 0;
+  }
+  int         exponent = 0;
+  const float mantissa = std::frexp(fps, &exponent); // fps = mantissa * 2^exponent, mantissa in [0.5, 1)
+  const auto  octave   = static_cast<size_t>(exponent - 1);
+  if (octave >= OCTAVES) {
+    return SIZE - 1;
+  }
+  const auto sub = static_cast<size_t>((mantissa * 2.0F - 1.0F) * static_cast<float>(SUB_BUCKETS));
+  return 1 + octave * SUB_BUCKETS + std::min(sub, SUB_BUCKETS - 1);
+}
+
+float FpsRateHistogram::value_(size_t index) {
+  if (index == 0) {
+    return 0.0F;
+  }
+  const size_t octave = (index - 1) / SUB_BUCKETS;
+  const size_t sub    = (index - 1) % SUB_BUCKETS;
+  // Midpoint of the bucket.
+  return std::ldexp(1.0F + (static_cast<float>(sub) + 0.5F) / static_cast<float>(SUB_BUCKETS),
+                    static_cast<int>(octave));
+}
+
+void FpsRateHistogram::record(float fps) {
+  counts_[index_(fps)]++;
+  min_ = count_ == 0 ? fps : std::min(min_, fps);
+  max_ = count_ == 0 ? fps : std::max(max_, fps);
+  count_++;
+}
+
+float FpsRateHistogram::quantile(double q) const {
+  if (count_ == 0) {
+    return 0.0F;
+  }
+  const auto rank = static_cast<uint32_t>(q * static_cast<double>(count_ - 1));
+  uint32_t   seen = 0;
+  for (size_t i = 0; i < SIZE; i++) {
+    seen += counts_[i];
+    if (seen > rank) {
+      return std::clamp(value_(i), min_, max_);
+    }
+  }
+  return max_;
+}
+
+void FpsRateHistogram::reset() {
+  counts_.fill(0);
+  count_ = 0;
+  min_   = 0.0F;
+  max_   = 0.0F;
+}
+
+FpsRateEstimator::FpsRateEstimator(const FpsEstimatorConfig& config)
+    : bucket_ms_(std::max<int64_t>(config.bucket.count(), 1)),
+      buckets_(std::clamp<size_t>(config.buckets, 1, FPS_MAX_WINDOW_BUCKETS)),
+      ewma_tau_ms_(static_cast<float>(std::max<int64_t>(config.ewma_tau.count(), 1))) {}
+
+void FpsRateEstimator::advance_(int64_t bucket) {
+  if (bucket <= head_) {
+    return;
+  }
+  const auto steps = static_cast<size_t>(std::min<int64_t>(bucket - head_, static_cast<int64_t>(buckets_)));
+  for (size_t i = 1; i <= steps; i++) {
+    const size_t slot = static_cast<size_t>(head_ + static_cast<int64_t>(i)) % buckets_;
+    window_sum_ -= window_[slot];
+    window_[slot] = 0;
+  }
+  head_ = bucket;
+}
+
+void FpsRateEstimator::observe(int64_t now_ms, uint64_t total, uint32_t generation) {
+  if (has_last_ && (generation != generation_ || total < last_total_)) {
+    reset();
+  }
+  generation_ = generation;
+  if (!has_last_) {
+    has_last_   = true;
+    last_ts_    = now_ms;
+    last_total_ = total;
+    head_       = now_ms / bucket_ms_;
+    return;
+  }
+
+  const uint64_t delta = total - last_total_;
+  const int64_t  dt    = now_ms - last_ts_;
+  advance_(now_ms / bucket_ms_);
+  // The delta covers everything since the previous observation, which may reach back past the window; window_rate()
+  // divides by that longer span rather than spreading the count.
+  const size_t slot = static_cast<size_t>(head_) % buckets_;
+  if (window_[slot] == 0) {
+    since_[slot] = last_ts_;
+  }
+  window_[slot] += delta;
+  window_sum_ += delta;
+  last_total_ = total;
+  if (dt <= 0) {
+    return;
+  }
+  last_ts_ = now_ms;
+
+  const float instant = static_cast<float>(delta) * MILLI_SECONDS_IN_SECONDS / static_cast<float>(dt);
+  if (has_ewma_) {
+    ewma_ += (1.0F - std::exp(-static_cast<float>(dt) / ewma_tau_ms_)) * (instant - ewma_);
+  } else {
+    ewma_     = instant;
+    has_ewma_ = true;
+  }
+  histogram_.record(instant);
+
+  published_window_.store(window_rate(), std::memory_order_relaxed);
+  published_ewma_.store(ewma_, std::memory_order_relaxed);
+}
+
+void FpsRateEstimator::close_interval() {
+  const FpsRateStats stats = current();
+  published_min_.store(stats.min, std::memory_order_relaxed);
+  published_max_.store(stats.max, std::memory_order_relaxed);
+  published_p50_.store(stats.p50, std::memory_order_relaxed);
+  published_p99_.store(stats.p99, std::memory_order_relaxed);
+  published_samples_.store(stats.samples, std::memory_order_relaxed);
+  histogram_.reset();
+}
+
+void FpsRateEstimator::reset() {
+  window_.fill(0);
+  since_.fill(0);
+  window_sum_ = 0;
+  head_       = 0;
+  has_last_   = false;
+  last_ts_    = 0;
+  last_total_ = 0;
+  ewma_       = 0.0F;
+  has_ewma_   = false;
+  histogram_.reset();
+}
+
+float FpsRateEstimator::window_rate() const {
+  int64_t span = bucket_ms_ * static_cast<int64_t>(buckets_);
+  for (size_t i = 0; i < buckets_; i++) {
+    if (window_[i] != 0) {
+      span = std::max(span, last_ts_ - since_[i]);
+    }
+  }
+  return static_cast<float>(window_sum_) * MILLI_SECONDS_IN_SECONDS / static_cast<float>(span);
+}
+
+FpsRateStats FpsRateEstimator::current() const {
+  FpsRateStats stats;
+  stats.window  = window_rate();
+  stats.ewma    = ewma_;
+  stats.min     = histogram_.min();
+  stats.max     = histogram_.max();
+  stats.p50     = histogram_.quantile(P50);
+  stats.p99     = histogram_.quantile(P99);
+  stats.samples = histogram_.count();
+  return stats;
+}
+
+FpsRateStats FpsRateEstimator::published() const {
+  FpsRateStats stats;
+  stats.window  = published_window_.load(std::memory_order_relaxed);
+  stats.ewma    = published_ewma_.load(std::memory_order_relaxed);
+  stats.min     = published_min_.load(std::memory_order_relaxed);
+  stats.max     = published_max_.load(std::memory_order_relaxed);
+  stats.p50     = published_p50_.load(std::memory_order_relaxed);
+  stats.p99     = published_p99_.load(std::memory_order_relaxed);
+  stats.samples = published_samples_.load(std::memory_order_relaxed);
+  return stats;
+}
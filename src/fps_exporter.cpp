@@ -0,0 +1,278 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#include "fps_exporter.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#if !defined(_WIN32)
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr const char* UNIX_PREFIX      = "unix:";
+constexpr const char* DEFAULT_HOST     = "127.0.0.1";
+constexpr int         LISTEN_BACKLOG   = 16;
+constexpr int         REQUEST_TIMEOUT  = 1000; // milliseconds to wait for the whole request once connected
+constexpr int         RESPONSE_TIMEOUT = 5000; // milliseconds a scraper gets to read the whole response
+constexpr size_t      REQUEST_LIMIT    = 4096;
+
+constexpr std::string_view RESPONSE_HEADER = "HTTP/1.1 200 OK\r\n"
+                                             "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                                             "Connection: close\r\n"
+                                             "Content-Length: ";
+constexpr std::string_view NOT_READY       = "HTTP/1.1 503 Service Unavailable\r\n"
+                                             "Connection: close\r\n"
+                                             "Content-Length: 0\r\n\r\n";
+
+#if !defined(_WIN32)
+int listen_unix(const std::string& path) {
+  sockaddr_un address{};
+  if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+    return -1;
+  }
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    return -1;
+  }
+  address.sun_family = AF_UNIX;
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+  ::unlink(path.c_str());
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  if (::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+      ::listen(fd, LISTEN_BACKLOG) != 0) {
+    ::close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+int listen_tcp(const std::string& endpoint) {
+  const size_t colon = endpoint.rfind(':');
+  if (colon == std::string::npos) {
+    return -1;
+  }
+  const std::string host = colon == 0 ? DEFAULT_HOST : endpoint.substr(0, colon);
+  sockaddr_in       address{};
+  address.sin_family = AF_INET;
+  try {
+    const unsigned long port = std::stoul(endpoint.substr(colon + 1));
+    if (port > UINT16_MAX) {
+      return -1;
+    }
+    address.sin_port = htons(static_cast<uint16_t>(port));
+  } catch (const std::exception&) {
+    return -1;
+  }
+  if (::inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) {
+    return -1;
+  }
+  const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    return -1;
+  }
+  const int reuse = 1;
+  ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  if (::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+      ::listen(fd, LISTEN_BACKLOG) != 0) {
+    ::close(fd);
+    return -1;
+  }
+  return fd;
+}
+#endif
+} // namespace
+
+FpsExporter::~FpsExporter() { close(); }
+
+bool FpsExporter::open(const std::string& endpoint) {
+#if defined(_WIN32)
+  (void)endpoint;
+  return false;
+#else
+  close();
+  if (endpoint.rfind(UNIX_PREFIX, 0) == 0) {
+    unix_path_ = endpoint.substr(std::strlen(UNIX_PREFIX));
+    listen_fd_ = listen_unix(unix_path_);
+  } else {
+    listen_fd_ = listen_tcp(endpoint);
+  }
+  if (listen_fd_ < 0 || ::pipe2(wake_fds_, O_CLOEXEC) != 0) {
+    close();
+    return false;
+  }
+  thread_ = std::make_unique<std::thread>([this] { run_(); });
+  return true;
+#endif
+}
+
+void FpsExporter::close() {
+#if !defined(_WIN32)
+  if (thread_) {
+    const char wake = 1;
+    [[maybe_unused]] const ssize_t result = ::write(wake_fds_[1], &wake, 1);
+    thread_->join();
+    thread_.reset();
+  }
+  for (int& fd : wake_fds_) {
+    if (fd >= 0) {
+      ::close(fd);
+      fd = -1;
+    }
+  }
+  if (listen_fd_ >= 0) {
+    ::close(listen_fd_);
+    listen_fd_ = -1;
+  }
+  if (!unix_path_.empty()) {
+    ::unlink(unix_path_.c_str());
+    unix_path_.clear();
+  }
+#endif
+}
+
+void FpsExporter::publish(std::string_view body) {
+  // The previous front becomes the back buffer again unless a scrape is still writing it out.
+  if (!back_ || back_.use_count() > 1) {
+    back_ = std::make_shared<std::string>();
+  }
+  // Orders our writes after the last scrape's reads of a reused buffer.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const std::string length = std::to_string(body.size());
+  back_->clear();
+  back_->reserve(RESPONSE_HEADER.size() + length.size() + 4 + body.size());
+  back_->append(RESPONSE_HEADER).append(length).append("\r\n\r\n").append(body);
+
+  std::shared_ptr<const std::string> previous;
+  {
+    const std::lock_guard<std::mutex> lock(front_mtx_);
+    previous = std::move(front_);
+    front_   = std::move(back_);
+  }
+  back_ = std::const_pointer_cast<std::string>(previous);
+}
+
+std::shared_ptr<const std::string> FpsExporter::front_buffer_() {
+  const std::lock_guard<std::mutex> lock(front_mtx_);
+  return front_;
+}
+
+void FpsExporter::run_() {
+#if !defined(_WIN32)
+  for (;;) {
+    pollfd fds[2] = {{listen_fd_, POLLIN, 0}, {wake_fds_[0], POLLIN, 0}}; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    if (::poll(fds, 2, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return;
+    }
+    if ((fds[1].revents & POLLIN) != 0) {
+      return;
+    }
+    if ((fds[0].revents & POLLIN) != 0) {
+      const int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK);
+      if (fd >= 0) {
+        serve_(fd);
+        ::close(fd);
+      }
+    }
+  }
+#endif
+}
+
+bool FpsExporter::wait_(int fd, short events, clock_type::time_point deadline) {
+#if defined(_WIN32)
+  (void)fd;
+  (void)events;
+  (void)deadline;
+  return false;
+#else
+  for (;;) {
+    const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - clock_type::now()).count();
+    if (left <= 0) {
+      return false;
+    }
+    pollfd fds[2] = {{fd, events, 0}, {wake_fds_[0], POLLIN, 0}}; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    const int ready = ::poll(fds, 2, static_cast<int>(left));
+    if (ready < 0 && errno == EINTR) {
+      continue;
+    }
+    // close() wins over a ready client.
+    return ready > 0 && (fds[1].revents & POLLIN) == 0 && fds[0].revents != 0;
+  }
+#endif
+}
+
+bool FpsExporter::send_(int fd, const char* data, size_t size) {
+#if defined(_WIN32)
+  (void)fd;
+  (void)data;
+  (void)size;
+  return false;
+#else
+  const auto deadline = clock_type::now() + std::chrono::milliseconds(RESPONSE_TIMEOUT);
+  while (size > 0) {
+    const ssize_t written = ::send(fd, data, size, MSG_NOSIGNAL);
+    if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+      if (!wait_(fd, POLLOUT, deadline)) {
+        return false;
+      }
+      continue;
+    }
+    if (written <= 0) {
+      return false;
+    }
+    data += written; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    size -= static_cast<size_t>(written);
+  }
+  return true;
+#endif
+}
+
+void FpsExporter::serve_(int fd) {
+#if defined(_WIN32)
+  (void)fd;
+#else
+  // Wait for the end of the request headers; the path and method are not interpreted. The client socket is
+  // non-blocking and every wait has a deadline and watches the wake pipe, so a stalled scraper can hold up the others
+  // for at most a timeout and never delays close().
+  const auto deadline = clock_type::now() + std::chrono::milliseconds(REQUEST_TIMEOUT);
+  char       request[REQUEST_LIMIT]; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+  size_t     received = 0;
+  while (received < sizeof(request)) {
+    if (!wait_(fd, POLLIN, deadline)) {
+      return;
+    }
+    const ssize_t count = ::recv(fd, request + received, sizeof(request) - received, 0);
+    if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+      continue;
+    }
+    if (count <= 0) {
+      return;
+    }
+    received += static_cast<size_t>(count);
+    if (std::string_view(request, received).find("\r\n\r\n") != std::string_view::npos) {
+      break;
+    }
+  }
+  const std::shared_ptr<const std::string> response = front_buffer_();
+  if (!response) {
+    send_(fd, NOT_READY.data(), NOT_READY.size());
+    return;
+  }
+  if (send_(fd, response->data(), response->size())) {
+    scrapes_.fetch_add(1, std::memory_order_relaxed);
+  }
+#endif
+}
@@ -0,0 +1,237 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#include "fps_health.h"
+
+#include <algorithm>
+
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr uint64_t RATE_GRACE_PASSES = 2;
+} // namespace
+
+const char* to_string(FpsHealthState state) {
+  switch (state) {
+  case FpsHealthState::UNKNOWN:
+    return "unknown";
+  case FpsHealthState::HEALTHY:
+    return "healthy";
+  case FpsHealthState::DEGRADED:
+    return "degraded";
+  case FpsHealthState::STALLED:
+    return "stalled";
+  }
+  return "unknown";
+}
+
+FpsHealth::~FpsHealth() {
+#if defined(__linux__)
+  if (event_fd_ >= 0) {
+    ::close(event_fd_);
+  }
+#endif
+}
+
+void FpsHealth::set_rule(const FpsHealthRule& rule) {
+  const std::lock_guard<std::mutex> lock(rules_mtx_);
+  default_rule_ = rule;
+  rules_version_.fetch_add(1, std::memory_order_release);
+}
+
+void FpsHealth::set_rule(uint64_t app_id, const FpsHealthRule& rule) {
+  const std::lock_guard<std::mutex> lock(rules_mtx_);
+  app_rules_[app_id] = rule;
+  rules_version_.fetch_add(1, std::memory_order_release);
+}
+
+void FpsHealth::set_rule(uint64_t app_id, uint64_t channel_id, const FpsHealthRule& rule) {
+  const std::lock_guard<std::mutex> lock(rules_mtx_);
+  channel_rules_[{app_id, channel_id}] = rule;
+  rules_version_.fetch_add(1, std::memory_order_release);
+}
+
+void FpsHealth::clear_rule(uint64_t app_id) {
+  const std::lock_guard<std::mutex> lock(rules_mtx_);
+  app_rules_.erase(app_id);
+  rules_version_.fetch_add(1, std::memory_order_release);
+}
+
+void FpsHealth::clear_rule(uint64_t app_id, uint64_t channel_id) {
+  const std::lock_guard<std::mutex> lock(rules_mtx_);
+  channel_rules_.erase({app_id, channel_id});
+  rules_version_.fetch_add(1, std::memory_order_release);
+}
+
+FpsHealthRule FpsHealth::rule(const FpsKey& key) const {
+  const std::lock_guard<std::mutex> lock(rules_mtx_);
+  if (!channel_rules_.empty()) {
+    auto it = channel_rules_.find({key.app_id, key.channel_id});
+    if (it != channel_rules_.end()) {
+      return it->second;
+    }
+  }
+  if (!app_rules_.empty()) {
+    auto it = app_rules_.find(key.app_id);
+    if (it != app_rules_.end()) {
+      return it->second;
+    }
+  }
+  return default_rule_;
+}
+
+uint64_t FpsHealth::subscribe(FpsHealthCallback callback) {
+  const std::lock_guard<std::mutex> lock(callbacks_mtx_);
+  const uint64_t                    id = next_callback_id_++;
+  callbacks_.emplace_back(id, std::move(callback));
+  return id;
+}
+
+bool FpsHealth::unsubscribe(uint64_t id) {
+  const std::lock_guard<std::mutex> lock(callbacks_mtx_);
+  auto it = std::find_if(callbacks_.begin(), callbacks_.end(), [id](const auto& entry) { return entry.first == id; });
+  if (it == callbacks_.end()) {
+    return false;
+  }
+  callbacks_.erase(it);
+  return true;
+}
+
+int FpsHealth::event_fd() {
+  const std::lock_guard<std::mutex> lock(events_mtx_);
+#if defined(__linux__)
+  if (event_fd_ < 0) {
+    event_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  }
+#endif
+  return event_fd_;
+}
+
+std::vector<FpsHealthEvent> FpsHealth::drain() {
+  const std::lock_guard<std::mutex> lock(events_mtx_);
+#if defined(__linux__)
+  if (event_fd_ >= 0) {
+    uint64_t count = 0;
+    [[maybe_unused]] const ssize_t result = ::read(event_fd_, &count, sizeof(count));
+  }
+#endif
+  std::vector<FpsHealthEvent> events(events_.begin(), events_.end());
+  events_.clear();
+  return events;
+}
+
+uint64_t FpsHealth::dropped_events() {
+  const std::lock_guard<std::mutex> lock(events_mtx_);
+  return dropped_events_;
+}
+
+FpsHealthState FpsHealth::state(const FpsStatus& status) const {
+  if (status.index >= channels_.size()) {
+    return FpsHealthState::UNKNOWN;
+  }
+  const Channel& channel = channels_[status.index];
+  if (!channel.is_tracked || channel.generation != status.generation.load(std::memory_order_acquire)) {
+    return FpsHealthState::UNKNOWN;
+  }
+  return channel.state;
+}
+
+FpsHealthRule FpsHealth::cached_rule(size_t index, uint32_t generation, const FpsKey& key) const {
+  if (index < channels_.size()) {
+    const Channel& channel = channels_[index];
+    if (channel.is_tracked && channel.generation == generation &&
+        channel.rule_version == rules_version_.load(std::memory_order_acquire)) {
+      return channel.rule;
+    }
+  }
+  return rule(key);
+}
+
+void FpsHealth::check(const FpsRegistry& registry, uint64_t sample_passes, int64_t now_ms, int64_t wall_ms) {
+  if (channels_.size() < registry.size()) {
+    channels_.resize(registry.size());
+  }
+  pending_.clear();
+  const uint64_t rules_version = rules_version_.load(std::memory_order_acquire);
+  registry.for_each([&](const FpsStatus& status) {
+    Channel&       channel    = channels_[status.index];
+    const uint32_t generation = status.generation.load(std::memory_order_acquire);
+    const uint64_t total      = status.total();
+    if (!channel.is_tracked || channel.generation != generation) {
+      channel              = Channel{};
+      channel.is_tracked   = true;
+      channel.generation   = generation;
+      channel.last_total   = total;
+      channel.last_tick_ms = now_ms;
+      channel.first_pass   = sample_passes;
+    }
+    if (channel.rule_version != rules_version) {
+      channel.rule         = rule(status.key());
+      channel.rule_version = rules_version;
+    }
+    if (total != channel.last_total) {
+      channel.last_total   = total;
+      channel.last_tick_ms = now_ms;
+    }
+
+    const int64_t  idle_ms  = now_ms - channel.last_tick_ms;
+    const int64_t  stall_ms = channel.rule.stall_timeout.count();
+    const float    fps      = registry.last_fps(status).load(std::memory_order_relaxed);
+    FpsHealthState next     = channel.state;
+    if (stall_ms > 0 && idle_ms >= stall_ms) {
+      next = FpsHealthState::STALLED;
+    } else if (channel.state == FpsHealthState::STALLED) {
+      // Ticking again; the rate is judged once a full sampling interval has passed since.
+      next               = FpsHealthState::HEALTHY;
+      channel.first_pass = sample_passes;
+    } else if (sample_passes >= channel.first_pass + RATE_GRACE_PASSES) {
+      next = channel.rule.min_fps <= fps && fps <= channel.rule.max_fps ? FpsHealthState::HEALTHY
+                                                                         : FpsHealthState::DEGRADED;
+    }
+    if (next != channel.state) {
+      pending_.push_back(FpsHealthEvent{status.key(), channel.state, next, fps, idle_ms, wall_ms});
+      channel.state = next;
+    }
+  });
+  if (!pending_.empty()) {
+    dispatch_();
+  }
+}
+
+void FpsHealth::dispatch_() {
+  {
+    std::vector<FpsHealthCallback> callbacks;
+    {
+      const std::lock_guard<std::mutex> lock(callbacks_mtx_);
+      callbacks.reserve(callbacks_.size());
+      for (const auto& entry : callbacks_) {
+        callbacks.push_back(entry.second);
+      }
+    }
+    for (const FpsHealthEvent& event : pending_) {
+      for (const FpsHealthCallback& callback : callbacks) {
+        callback(event);
+      }
+    }
+  }
+  {
+    const std::lock_guard<std::mutex> lock(events_mtx_);
+    if (event_fd_ >= 0) {
+      for (const FpsHealthEvent& event : pending_) {
+        if (events_.size() == MAX_QUEUED_EVENTS) {
+          events_.pop_front();
+          dropped_events_++;
+        }
+        events_.push_back(event);
+      }
+#if defined(__linux__)
+      const uint64_t                 one    = 1;
+      [[maybe_unused]] const ssize_t result = ::write(event_fd_, &one, sizeof(one));
+#endif
+    }
+  }
+}
@@ -0,0 +1,64 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#include "fps_jitter.h"
+
+#include <algorithm>
+
+namespace {
+constexpr float  MICRO_SECONDS_IN_MILLI_SECONDS = 1000.0F;
+constexpr double P50                            = 0.5;
+constexpr double P99                            = 0.99;
+} // namespace
+
+float FpsJitter::value_ms_(size_t index) {
+  if (index < SUB_BUCKETS) {
+    return static_cast<float>(index) / MICRO_SECONDS_IN_MILLI_SECONDS;
+  }
+  const size_t   exponent = index / SUB_BUCKETS + 1;
+  const uint64_t width    = uint64_t{1} << (exponent - SUB_BUCKET_BITS);
+  const uint64_t lower    = (SUB_BUCKETS + index % SUB_BUCKETS) * width;
+  // Midpoint of the bucket.
+  return (static_cast<float>(lower) + static_cast<float>(width) / 2.0F) / MICRO_SECONDS_IN_MILLI_SECONDS;
+}
+
+FpsJitterStats FpsJitter::read(bool reset) {
+  std::array<uint32_t, BUCKETS> counts{};
+  FpsJitterStats                stats;
+  for (size_t i = 0; i < BUCKETS; i++) {
+    counts[i] =
+        reset ? buckets_[i].exchange(0, std::memory_order_relaxed) : buckets_[i].load(std::memory_order_relaxed);
+    stats.gaps += counts[i];
+  }
+  if (stats.gaps == 0) {
+    return stats;
+  }
+
+  const auto p50_rank = static_cast<uint32_t>(P50 * (stats.gaps - 1));
+  const auto p99_rank = static_cast<uint32_t>(P99 * (stats.gaps - 1));
+  uint32_t   seen     = 0;
+  bool       has_p50  = false;
+  for (size_t i = 0; i < BUCKETS; i++) {
+    if (counts[i] == 0) {
+      continue;
+    }
+    seen += counts[i];
+    if (!has_p50 && seen > p50_rank) {
+      stats.p50 = value_ms_(i);
+      has_p50   = true;
+    }
+    if (stats.p99 == 0.0F && seen > p99_rank) {
+      stats.p99 = value_ms_(i);
+    }
+    stats.max = value_ms_(i);
+  }
+  return stats;
+}
+
+void FpsJitter::clear() {
+  for (auto&& bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  last_tick_ns_.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,156 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#include "fps_latency.h"
+
+int FpsLatency::stage(uint64_t thread_id) {
+  const std::lock_guard<std::mutex> lock(mtx_);
+  const uint32_t                    count = stage_count_.load(std::memory_order_relaxed);
+  for (uint32_t i = 0; i < count; i++) {
+    if (ids_[i] == thread_id) {
+      return static_cast<int>(i);
+    }
+  }
+  if (count == FPS_MAX_STAGES) {
+    return -1;
+  }
+  ids_[count] = thread_id;
+  stage_count_.store(count + 1, std::memory_order_release);
+  return static_cast<int>(count);
+}
+
+bool FpsLatency::has_stage(uint64_t thread_id) {
+  const std::lock_guard<std::mutex> lock(mtx_);
+  const uint32_t                    count = stage_count_.load(std::memory_order_relaxed);
+  for (uint32_t i = 0; i < count; i++) {
+    if (ids_[i] == thread_id) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void FpsLatency::reset(uint64_t app_id, uint64_t channel_id) {
+  const std::lock_guard<std::mutex> lock(mtx_);
+  app_id_     = app_id;
+  channel_id_ = channel_id;
+  ids_        = {};
+  stage_count_.store(0, std::memory_order_relaxed);
+  for (Stage& stage : stages_) {
+    for (auto& stamp : stage.stamps) {
+      stamp.store(0, std::memory_order_relaxed);
+    }
+    stage.from_previous.clear();
+    stage.from_first.clear();
+  }
+}
+
+FpsLatencyStats FpsLatency::read(bool reset) {
+  const uint32_t  count = stage_count_.load(std::memory_order_acquire);
+  FpsLatencyStats stats;
+  stats.app_id     = app_id_;
+  stats.channel_id = channel_id_;
+  stats.stages.reserve(count);
+  for (uint32_t i = 0; i < count; i++) {
+    FpsLatencyStage& stage = stats.stages.emplace_back();
+    stage.thread_id        = ids_[i];
+    if (i > 0) {
+      stage.from_previous = stages_[i].from_previous.read(reset);
+    }
+    if (i > 1) {
+      stage.from_first = stages_[i].from_first.read(reset);
+    }
+  }
+  return stats;
+}
+
+FpsLatency* FpsTracer::find_(uint64_t app_id, uint64_t channel_id) {
+  auto it = pipelines_.find({app_id, channel_id});
+  return it != pipelines_.end() ? it->second : nullptr;
+}
+
+void FpsTracer::drop_(std::map<std::pair<uint64_t, uint64_t>, FpsLatency*>::iterator it) {
+  // Handles see the new generation and stop marking; the memory waits in the pool for the next declare().
+  it->second->retire();
+  free_.push_back(it->second);
+  pipelines_.erase(it);
+  version_.fetch_add(1, std::memory_order_release);
+}
+
+bool FpsTracer::declare(uint64_t app_id, uint64_t channel_id, const std::vector<uint64_t>& stages) {
+  const std::lock_guard<std::mutex> lock(mtx_);
+  FpsLatency*                       latency = find_(app_id, channel_id);
+  if (latency == nullptr) {
+    if (free_.empty()) {
+      storage_.emplace_back(std::make_unique<FpsLatency>(app_id, channel_id));
+      latency = storage_.back().get();
+    } else {
+      latency = free_.back();
+      free_.pop_back();
+      latency->reset(app_id, channel_id);
+    }
+    pipelines_.emplace(std::make_pair(app_id, channel_id), latency);
+    version_.fetch_add(1, std::memory_order_release);
+  }
+  for (size_t i = 0; i < stages.size(); i++) {
+    if (latency->stage(stages[i]) != static_cast<int>(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+FpsTraceHandle FpsTracer::handle(uint64_t app_id, uint64_t channel_id, uint64_t thread_id) {
+  const std::lock_guard<std::mutex> lock(mtx_);
+  FpsLatency*                       latency = find_(app_id, channel_id);
+  if (latency == nullptr) {
+    return FpsTraceHandle{};
+  }
+  const int stage = latency->stage(thread_id);
+  if (stage < 0) {
+    return FpsTraceHandle{};
+  }
+  return FpsTraceHandle{latency, static_cast<uint32_t>(stage), latency->generation()};
+}
+
+bool FpsTracer::remove(uint64_t app_id, uint64_t channel_id) {
+  const std::lock_guard<std::mutex> lock(mtx_);
+  auto                              it = pipelines_.find({app_id, channel_id});
+  if (it == pipelines_.end()) {
+    return false;
+  }
+  drop_(it);
+  return true;
+}
+
+bool FpsTracer::remove(const FpsKey& key) {
+  const std::lock_guard<std::mutex> lock(mtx_);
+  auto                              it = pipelines_.find({key.app_id, key.channel_id});
+  if (it == pipelines_.end() || !it->second->has_stage(key.thread_id)) {
+    return false;
+  }
+  drop_(it);
+  return true;
+}
+
+FpsLatencyStats FpsTracer::read(uint64_t app_id, uint64_t channel_id, bool reset) {
+  // Held throughout, so a concurrent drop and reuse cannot relabel the pipeline mid-read.
+  const std::lock_guard<std::mutex> lock(mtx_);
+  FpsLatency*                       latency = find_(app_id, channel_id);
+  if (latency == nullptr) {
+    return FpsLatencyStats{app_id, channel_id, {}};
+  }
+  return latency->read(reset);
+}
+
+void FpsTracer::read_all(std::vector<FpsLatencyStats>& out, bool reset) {
+  out.clear();
+  const std::lock_guard<std::mutex> lock(mtx_);
+  for (auto& entry : pipelines_) {
+    FpsLatencyStats stats = entry.second->read(reset);
+    if (stats.stages.size() > 1) {
+      out.push_back(std::move(stats));
+    }
+  }
+}
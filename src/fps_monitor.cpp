@@ -3,13 +3,20 @@
 // *****************************************************
 
 #include "fps_monitor.h"
+#include "fps_monitor_group.h"
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <cmath>
 #include <cstdint>
 #include <ctime>
 #include <fmt/chrono.h>
 #include <fmt/core.h>
+#include <fmt/format.h>
+#include <fstream>
+#include <iterator>
 // #include <logging.h>
 #include <memory>
 #include <mutex>
@@ -18,20 +25,36 @@
 #include <sstream>
 #include <string>
 #include <thread>
-#include <tuple>
 #include <utility>
 #include <vector>
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
 static_assert(__cplusplus >= 201703L, "This file expects a C++17 compatible compiler.");
 
-constexpr int32_t LOG_INTERVAL_SEC         = 10;
 constexpr int32_t MAX_VALID_LIST_SIZE      = 100;
-constexpr int32_t MIN_ABNORMAL_FPS         = 8;
-constexpr int32_t MAX_ABNORMAL_FPS         = 1000;
-constexpr float   MILLI_SECONDS_IN_SECONDS = 1000.0F;
 constexpr int32_t STRFTIME_FORMAT_LENGTH   = 20;
+constexpr float   MILLI_SECONDS_IN_SECONDS = 1000.0F;
+constexpr int64_t MILLI_SECONDS_IN_SECOND  = 1000;
 namespace {
+constexpr size_t KEY_BATCH_CHUNK = 32;
+constexpr size_t TLS_CACHE_SIZE  = 16;
+struct TlsCacheEntry {
+  const FpsRegistry*         registry{nullptr};
+  FpsKey                     key;
+  FpsHandle                  handle;
+  std::atomic_uint_fast64_t* counter{nullptr};
+};
+// Per-thread direct-mapped cache so the key based C entry point skips the registry probe on repeat calls.
+thread_local std::array<TlsCacheEntry, TLS_CACHE_SIZE> tls_cache;
+struct TlsTraceEntry {
+  const FpsTracer* tracer{nullptr};
+  FpsKey           key;
+  FpsTraceHandle   handle;
+  uint64_t         version{0}; // tracer version the handle was resolved at
+};
+// Same for key based frame marks.
+thread_local std::array<TlsTraceEntry, TLS_CACHE_SIZE> tls_trace_cache;
+
 constexpr int max_size      = 1048576 * 5;
 constexpr int max_files     = 3;
 constexpr int banner_spaces = 80;
@@ -48,18 +71,38 @@ std::string printable_current_time() {
                      "", get_current_time_str(), banner_spaces);
 }
 
-void write_header(std::shared_ptr<spdlog::logger> logger, const std::string& header_msg) {
+void write_header(std::shared_ptr<spdlog::logger> logger, FpsSinkStats& stats, spdlog::string_view_t header_msg) {
   if (logger) {
-    logger->info(printable_current_time());
-    logger->info(header_msg);
+    const std::string banner = printable_current_time();
+    logger->info(banner);
+    logger->log(spdlog::level::info, header_msg);
+    stats.add(banner.size());
+    stats.add(header_msg.size());
   }
 }
-void write_log(std::shared_ptr<spdlog::logger> logger, const std::string& log_msg) {
+void write_log(std::shared_ptr<spdlog::logger> logger, FpsSinkStats& stats, spdlog::string_view_t log_msg) {
   if (logger) {
-    logger->info(log_msg);
-    logger->flush();
+    logger->log(spdlog::level::info, log_msg);
+    stats.add(log_msg.size());
   }
 }
+constexpr uint64_t NANO_SECONDS_IN_MICRO_SECONDS = 1000;
+uint64_t           to_us(uint64_t ns) { return ns / NANO_SECONDS_IN_MICRO_SECONDS; }
+spdlog::string_view_t to_string_view(const spdlog::memory_buf_t& buffer) {
+  return spdlog::string_view_t(buffer.data(), buffer.size());
+}
+void format_rollup(spdlog::memory_buf_t& buffer, const FpsRollupNode& node) {
+  fmt::format_to(std::back_inserter(buffer), "fps {:.1f} chn {} ok {} deg {} stall {} unk {}", node.fps, node.channels,
+                 node.count(FpsHealthState::HEALTHY), node.count(FpsHealthState::DEGRADED),
+                 node.count(FpsHealthState::STALLED), node.count(FpsHealthState::UNKNOWN));
+}
+std::string get_record_path(const std::string& session_folder, const std::string& base_name) {
+#if defined(_WIN32)
+  return fmt::format("{}\\{}.fpsr", session_folder, base_name);
+#else
+  return fmt::format("{}/{}.fpsr", session_folder, base_name);
+#endif
+}
 std::shared_ptr<spdlog::logger> get_logger_st_internal(const std::string& logger_name, const std::string& logger_path) {
   std::shared_ptr<spdlog::logger> logger = spdlog::get(logger_name);
   if (logger == nullptr) {
@@ -116,33 +159,44 @@ std::shared_ptr<spdlog::logger> get_logger_st(const std::string& session_folder,
 }
 } // namespace
 
-FpsStatus::FpsStatus(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, bool dump_in_log)
-    : FpsStatus(app_id, channel_id, thread_id, 0, 0, dump_in_log) {}
-
-// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-FpsStatus::FpsStatus(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, uint64_t value, uint64_t last_value,
-                     bool dump_in_log)
-    : app_id(app_id), channel_id(channel_id), thread_id(thread_id), value(value), last_value(last_value),
-      dump_in_log(dump_in_log), last_fps(0.0) {}
-
-FpsMonitor::FpsMonitor(std::string session_dir, std::string file_name)
-    : session_dir_(std::move(session_dir)), file_name_(std::move(file_name)), last_write_ts_(0) {
-  thread_ = std::make_unique<std::thread>(&FpsMonitor::run_, this);
+FpsMonitor::FpsMonitor(FpsMonitorGroup& group, std::string name, std::string session_dir, std::string file_name,
+                       const FpsMonitorConfig& config)
+    : group_(group), name_(std::move(name)), session_dir_(std::move(session_dir)), file_name_(std::move(file_name)),
+      clock_(config.clock != nullptr ? config.clock : &FpsClock::steady()), last_write_ts_(0),
+      shm_name_(config.shm_name), shm_capacity_(config.shm_capacity), metrics_endpoint_(config.metrics_endpoint) {
+  config_.sample_interval     = std::max(config.sample_interval, FpsMonitorConfig::MIN_INTERVAL);
+  config_.log_interval        = std::max(config.log_interval, FpsMonitorConfig::MIN_INTERVAL);
+  config_.idle_ttl            = config.idle_ttl;
+  config_.health_interval     = config.health_interval > std::chrono::milliseconds::zero()
+                                    ? std::max(config.health_interval, FpsMonitorConfig::MIN_INTERVAL)
+                                    : config.health_interval;
+  config_.manual              = config.manual;
+  config_.log_self_stats      = config.log_self_stats;
+  config_.log_epsilon         = config.log_epsilon;
+  config_.log_keyframe_passes = config.log_keyframe_passes;
+  config_.record              = config.record;
+  idle_ttl_ms_                = config.idle_ttl.count();
+  log_self_stats_             = config.log_self_stats;
+  log_epsilon_                = config.log_epsilon;
+  log_keyframe_passes_        = config.log_keyframe_passes;
+  do_record_                  = config.record;
 }
 
 void FpsMonitor::shutDown() {
-  do_shutdown_ = true;
-  if (thread_) {
-    if (thread_) {
-      thread_->join();
-    }
-    thread_ = nullptr;
+  std::unique_lock<std::mutex> lock(group_.mtx_);
+  if (is_closed_) {
+    return;
   }
-
-  for (auto&& itr : resource_map_) {
-    itr.second.reset();
-    itr.second = nullptr;
+  do_shutdown_ = true;
+  if (group_.is_running_) {
+    group_.wake_();
+    group_.cv_.wait(lock, [&] { return is_closed_; });
+    return;
   }
+  lock.unlock();
+  final_pass_();
+  lock.lock();
+  is_closed_ = true;
 }
 FpsMonitor::~FpsMonitor() { shutDown(); }
 
@@ -150,13 +204,14 @@ auto FpsMonitor::getInstance() -> FpsMonitor& { return getInstance("session", "f
 auto FpsMonitor::close() -> void { getInstance().shutDown(); }
 
 auto FpsMonitor::getInstance(std::string session_dir, std::string file_name) -> FpsMonitor& {
-  static FpsMonitor instance(std::move(session_dir), std::move(file_name));
+  static FpsMonitor& instance = FpsMonitorGroup::getInstance().create(
+      FpsMonitorGroup::DEFAULT_MONITOR, std::move(session_dir), std::move(file_name));
   return instance;
 }
 
 auto FpsMonitor::set_status(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, bool dump_in_log)
     -> std::atomic_uint_fast64_t& {
-  return FpsMonitor::getInstance().set_status_(app_id, channel_id, thread_id, dump_in_log);
+  return FpsMonitor::getInstance().status(app_id, channel_id, thread_id, dump_in_log);
 }
 auto FpsMonitor::set_status_reference(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, bool dump_in_log)
     -> void {
@@ -165,228 +220,875 @@ auto FpsMonitor::set_status_reference(uint64_t app_id, uint64_t channel_id, uint
 
 auto FpsMonitor::set_status_reference_(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, bool dump_in_log)
     -> void {
-  auto key = std::tuple<uint64_t, uint64_t, uint64_t>(app_id, channel_id, thread_id);
-  auto itr = resource_map_reference_.end();
-  {
-    const std::lock_guard<std::mutex> lock(resource_map_reference_mtx_);
-
-    itr = resource_map_reference_.find(key);
-  }
-  if (itr != resource_map_reference_.end()) {
-    itr->second++;
+  const FpsKey   key{app_id, channel_id, thread_id};
+  TlsCacheEntry& entry = tls_cache[key.hash() % TLS_CACHE_SIZE];
+  if (entry.registry == &registry_ && entry.key == key && entry.handle.valid()) {
+    entry.counter->fetch_add(1, std::memory_order_relaxed);
+    entry.handle.status->record_arrival();
     return;
   }
-  {
-    const std::lock_guard<std::mutex> lock(resource_map_reference_mtx_);
-    auto map = resource_map_reference_.emplace(key, set_status_(app_id, channel_id, thread_id, dump_in_log));
+  std::atomic_uint_fast64_t& counter = set_status_(app_id, channel_id, thread_id, dump_in_log);
+  if (FpsStatus* status = registry_.find(key)) {
+    entry = TlsCacheEntry{&registry_, key, FpsHandle{status, status->generation.load()}, &counter};
   }
 }
 
+auto FpsMonitor::acquire(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, bool dump_in_log)
+    -> std::atomic_uint_fast64_t& {
+  return FpsMonitor::getInstance().counter(app_id, channel_id, thread_id, dump_in_log);
+}
+
+auto FpsMonitor::get_handle(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, bool dump_in_log)
+    -> FpsHandle {
+  return FpsMonitor::getInstance().handle(app_id, channel_id, thread_id, dump_in_log);
+}
+
+auto FpsMonitor::unregister(uint64_t app_id, uint64_t channel_id, uint64_t thread_id) -> bool {
+  return FpsMonitor::getInstance().remove(app_id, channel_id, thread_id);
+}
+
+auto FpsMonitor::enable_striping(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, size_t stripe_count)
+    -> bool {
+  return FpsMonitor::getInstance().stripe(app_id, channel_id, thread_id, stripe_count);
+}
+
+auto FpsMonitor::acquire_(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, bool dump_in_log) -> FpsStatus& {
+  return *insert_(FpsKey{app_id, channel_id, thread_id}, dump_in_log).first;
+}
+
 auto FpsMonitor::set_status_(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, bool dump_in_log)
     -> std::atomic_uint_fast64_t& {
-  auto key = std::tuple<uint64_t, uint64_t, uint64_t>(app_id, channel_id, thread_id);
+  const FpsKey key{app_id, channel_id, thread_id};
 
-  const std::lock_guard<std::mutex> lock(resource_map_mtx_);
+  FpsStatus* status = registry_.find(key);
+  if (status == nullptr) {
+    auto inserted = insert_(key, dump_in_log);
+    if (inserted.second) {
+      return inserted.first->counter();
+    }
+    status = inserted.first;
+  }
+  std::atomic_uint_fast64_t& counter = status->counter();
+  counter++;
+  status->record_arrival();
+  if (status->dump_in_log.load(std::memory_order_relaxed) != dump_in_log) {
+    status->dump_in_log = dump_in_log;
+  }
+  return counter;
+}
 
-  auto itr = resource_map_.find(key);
-  if (itr != resource_map_.end()) {
-    itr->second->value++;
-    itr->second->dump_in_log = dump_in_log;
-    return itr->second->value;
+auto FpsMonitor::insert_(const FpsKey& key, bool dump_in_log) -> std::pair<FpsStatus*, bool> {
+  auto inserted = registry_.find_or_insert(key, dump_in_log);
+  if (inserted.second) {
+    request_thread_();
   }
+  return inserted;
+}
 
-  auto map =
-      resource_map_.emplace(key, std::move(std::make_unique<FpsStatus>(app_id, channel_id, thread_id, dump_in_log)));
-  return map.first->second->value;
+void FpsMonitor::request_thread_() {
+  if (is_thread_requested_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  const std::lock_guard<std::mutex> lock(group_.mtx_);
+  if (!is_thread_requested_.exchange(true) && !config_.manual) {
+    group_.start_();
+  }
 }
 
 void FpsMonitor::write_header_(std::shared_ptr<spdlog::logger> logger_,
                                std::shared_ptr<spdlog::logger> summary_logger_) {
   {
-    std::stringstream ss_header;
-    std::stringstream ss_data;
-    const std::time_t time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    const std::time_t time = static_cast<std::time_t>(clock_->wall_ms() / MILLI_SECONDS_IN_SECOND);
 
     char time_buf[STRFTIME_FORMAT_LENGTH]; // NOLINT
     // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
     strftime(time_buf, STRFTIME_FORMAT_LENGTH, "%y-%m-%d", localtime(&time));
     // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
-    std::string const current_time(time_buf);
-
-    {
-      const std::lock_guard<std::mutex> lock(resource_map_mtx_);
-      for (auto&& itr : resource_map_) {
-        if (itr.second->dump_in_log) {
-          ss_header << "Time     App .Chn .Thr        Fps|";
-          ss_data << fmt::format("{} {:04}.{:04}.{:04}       fps|", current_time, itr.second->app_id.load(),
-                                 itr.second->channel_id.load(), itr.second->thread_id.load());
-        }
+    const fmt::string_view current_time(time_buf);
+
+    header_buffer_.clear();
+    line_buffer_.clear();
+    for (auto&& sample : snapshot_.samples) {
+      if (sample.dump_in_log && sample.is_timed) {
+        fmt::format_to(std::back_inserter(header_buffer_), "Time     App .Chn .Thr        Fps   Jit50ms   Jit99ms|");
+        fmt::format_to(std::back_inserter(line_buffer_), "{} {:04}.{:04}.{:04}       fps    jitter    jitter|",
+                       current_time, sample.key.app_id, sample.key.channel_id, sample.key.thread_id);
+      } else if (sample.dump_in_log) {
+        fmt::format_to(std::back_inserter(header_buffer_), "Time     App .Chn .Thr        Fps|");
+        fmt::format_to(std::back_inserter(line_buffer_), "{} {:04}.{:04}.{:04}       fps|", current_time,
+                       sample.key.app_id, sample.key.channel_id, sample.key.thread_id);
       }
     }
 
-    if (!ss_header.str().empty() && !ss_data.str().empty()) {
-      write_header(logger_, ss_header.str());
-      write_log(logger_, ss_data.str());
+    if (header_buffer_.size() != 0 && line_buffer_.size() != 0) {
+      write_header(logger_, log_sink_, to_string_view(header_buffer_));
+      write_log(logger_, log_sink_, to_string_view(line_buffer_));
     }
   }
 
   {
-    std::stringstream ss_summary;
-    {
-      const std::lock_guard<std::mutex> lock(resource_map_mtx_);
-      ss_summary << "Total channels (x2) " << resource_map_.size();
-    }
-
-    if (!ss_summary.str().empty()) {
-      write_header(summary_logger_, ss_summary.str());
-    }
+    line_buffer_.clear();
+    fmt::format_to(std::back_inserter(line_buffer_), "Total channels (x2) {}", snapshot_.samples.size());
+    write_header(summary_logger_, summary_sink_, to_string_view(line_buffer_));
   }
 }
 
 void FpsMonitor::calculate_fps_() {
-  const int64_t current_ts = std::chrono::time_point_cast<std::chrono::milliseconds>(std::chrono::system_clock::now())
-                                 .time_since_epoch()
-                                 .count();
-
-  const int64_t time_diff = current_ts - last_write_ts_;
+  // Intervals come from the monotonic clock; the wall clock only labels the snapshot.
+  const int64_t current_ts = clock_->now_ms();
+  const int64_t time_diff  = current_ts - last_sample_ts_;
   if (time_diff <= 0) {
     return;
   }
-  const std::lock_guard<std::mutex> lock(resource_map_mtx_);
-  for (auto&& itr : resource_map_) {
-    auto value_diff = itr.second->value - itr.second->last_value;
-    auto fps        = static_cast<float>(value_diff) * MILLI_SECONDS_IN_SECONDS / static_cast<float>(time_diff);
-    itr.second->last_value.store(itr.second->value);
-    itr.second->last_fps = fps;
+  registry_.compute_rates(time_diff, current_ts);
+  const uint64_t registrations = registry_.registrations();
+  registration_rate_.store(static_cast<float>(registrations - last_registrations_) * MILLI_SECONDS_IN_SECONDS /
+                               static_cast<float>(time_diff),
+                           std::memory_order_relaxed);
+  last_registrations_ = registrations;
+  last_sample_ts_     = current_ts;
+  last_write_ts_      = clock_->wall_ms();
+
+  const int64_t idle_ttl_ms = idle_ttl_ms_.load(std::memory_order_relaxed);
+  if (idle_ttl_ms > 0) {
+    evicted_.clear();
+    registry_.evict_idle(current_ts, idle_ttl_ms, &evicted_);
+    for (const FpsKey& key : evicted_) {
+      tracer_.remove(key);
+    }
   }
-  last_write_ts_ = current_ts;
+}
+
+void FpsMonitor::take_snapshot_(bool close_interval) {
+  const auto start = std::chrono::steady_clock::now();
+
+  snapshot_.ts = last_write_ts_;
+  snapshot_.samples.clear();
+  snapshot_cells_.clear();
+  snapshot_timed_count_ = 0;
+  registry_.for_each([&](const FpsStatus& status) {
+    snapshot_cells_.push_back(SnapshotCell{status.index, status.generation.load(std::memory_order_acquire)});
+    FpsSample& sample  = snapshot_.samples.emplace_back();
+    sample.key         = status.key();
+    sample.value       = registry_.sample(status);
+    sample.fps         = registry_.last_fps(status).load(std::memory_order_relaxed);
+    sample.dump_in_log = status.dump_in_log.load(std::memory_order_relaxed);
+    if (FpsJitter* timing = status.jitter.load(std::memory_order_acquire)) {
+      sample.is_timed = true;
+      sample.jitter   = timing->read(close_interval);
+      snapshot_timed_count_ += sample.dump_in_log ? 1 : 0;
+    }
+  });
+  tracer_.read_all(snapshot_.latencies, close_interval);
+
+  snapshot_duration_ns_.store(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count(),
+      std::memory_order_relaxed);
 }
 
 void FpsMonitor::write_data_(std::shared_ptr<spdlog::logger> logger_, std::shared_ptr<spdlog::logger> summary_logger_) {
-  calculate_fps_();
+  const float    epsilon         = log_epsilon_.load(std::memory_order_relaxed);
+  const uint32_t keyframe_passes = log_keyframe_passes_.load(std::memory_order_relaxed);
+  bool           is_keyframe     = epsilon <= 0.0F || do_write_header_ || logged_.size() != snapshot_.samples.size() ||
+                                   (keyframe_passes != 0 && passes_since_keyframe_ + 1 >= keyframe_passes);
+  passes_since_keyframe_ = is_keyframe ? 0 : passes_since_keyframe_ + 1;
+  if (is_keyframe) {
+    logged_.resize(snapshot_.samples.size());
+  }
   if (do_write_header_) {
     do_write_header_ = false;
     write_header_(logger_, summary_logger_);
   }
 
-  std::vector<std::tuple<uint64_t, uint64_t, uint64_t>> valid_list;
-  std::vector<std::tuple<uint64_t, uint64_t, uint64_t>> invalid_list;
+  // On a keyframe the lists hold every key, otherwise only the keys that changed side.
+  valid_list_.clear();
+  invalid_list_.clear();
+  size_t valid_count   = 0;
+  size_t invalid_count = 0;
 
-  const std::time_t time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+  const std::time_t time = static_cast<std::time_t>(clock_->wall_ms() / MILLI_SECONDS_IN_SECOND);
 
   char time_buf[STRFTIME_FORMAT_LENGTH]; // NOLINT
   // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
   strftime(time_buf, STRFTIME_FORMAT_LENGTH, "%H:%M:%S", localtime(&time));
   // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
-  std::string const current_time(time_buf);
+  const fmt::string_view current_time(time_buf);
 
-  {
-    std::stringstream ss_data;
-    {
-      const std::lock_guard<std::mutex> lock(resource_map_mtx_);
-      for (auto&& itr : resource_map_) {
-        if (itr.second->dump_in_log) {
-
-          auto fps        = itr.second->last_fps.load();
-          auto app_id     = itr.second->app_id.load();
-          auto channel_id = itr.second->channel_id.load();
-          auto thread_id  = itr.second->thread_id.load();
-          ss_data << fmt::format("{} {:04}.{:04}.{:04} {:>9.{}f}|", current_time, app_id, channel_id, thread_id, fps,
-                                 1);
-
-          if (MIN_ABNORMAL_FPS <= fps && MAX_ABNORMAL_FPS >= fps) {
-            valid_list.emplace_back(itr.first);
-          } else {
-            invalid_list.emplace_back(itr.first);
-          }
+  for (;;) {
+    line_buffer_.clear();
+    for (size_t i = 0; i < snapshot_.samples.size(); i++) {
+      const FpsSample& sample = snapshot_.samples[i];
+      if (!sample.dump_in_log) {
+        continue;
+      }
+      const SnapshotCell& cell     = snapshot_cells_[i];
+      const FpsHealthRule rule     = health_.cached_rule(cell.index, cell.generation, sample.key);
+      const bool          is_valid = rule.min_fps <= sample.fps && rule.max_fps >= sample.fps;
+      LoggedChannel&      logged   = logged_[i];
+      const bool          is_moved = !is_keyframe && logged.is_valid != is_valid;
+      if (is_keyframe || is_moved || logged.key != sample.key || std::fabs(sample.fps - logged.fps) > epsilon) {
+        logged = LoggedChannel{sample.key, sample.fps, is_valid};
+        if (sample.is_timed) {
+          fmt::format_to(std::back_inserter(line_buffer_), "{} {:04}.{:04}.{:04} {:>9.{}f} {:>9.{}f} {:>9.{}f}|",
+                         current_time, sample.key.app_id, sample.key.channel_id, sample.key.thread_id, sample.fps, 1,
+                         sample.jitter.p50, 1, sample.jitter.p99, 1);
+        } else {
+          fmt::format_to(std::back_inserter(line_buffer_), "{} {:04}.{:04}.{:04} {:>9.{}f}|", current_time,
+                         sample.key.app_id, sample.key.channel_id, sample.key.thread_id, sample.fps, 1);
         }
       }
+      (is_valid ? valid_count : invalid_count)++;
+      if (is_keyframe || is_moved) {
+        (is_valid ? valid_list_ : invalid_list_).emplace_back(sample.key);
+      }
+    }
+    // A change list too long to print could not be replayed, so the pass turns into a keyframe instead.
+    if (!is_keyframe && (valid_list_.size() >= MAX_VALID_LIST_SIZE || invalid_list_.size() >= MAX_VALID_LIST_SIZE)) {
+      is_keyframe            = true;
+      passes_since_keyframe_ = 0;
+      valid_list_.clear();
+      invalid_list_.clear();
+      valid_count   = 0;
+      invalid_count = 0;
+      continue;
     }
 
-    if (!ss_data.str().empty()) {
-      write_log(logger_, ss_data.str());
+    if (line_buffer_.size() != 0) {
+      write_log(logger_, log_sink_, to_string_view(line_buffer_));
     }
+    break;
   }
 
   {
-    std::stringstream ss_summary;
-
-    auto valid_list_size = valid_list.size();
-    ss_summary << fmt::format("{} Valid   (x2) ({:04}) ", current_time, valid_list_size);
+    line_buffer_.clear();
+    auto valid_list_size = valid_list_.size();
+    fmt::format_to(std::back_inserter(line_buffer_), "{} Valid   (x2) ({:04}) ", current_time, valid_count);
     if (0 < valid_list_size && MAX_VALID_LIST_SIZE > valid_list_size) {
-      ss_summary << fmt::format(":");
-      for (auto&& itr : valid_list) {
-        ss_summary << fmt::format(" {:04}.{:04}.{:04}|", std::get<0>(itr), std::get<1>(itr), std::get<2>(itr));
+      line_buffer_.push_back(is_keyframe ? ':' : '+');
+      for (auto&& key : valid_list_) {
+        fmt::format_to(std::back_inserter(line_buffer_), " {:04}.{:04}.{:04}|", key.app_id, key.channel_id,
+                       key.thread_id);
       }
     }
-    write_log(summary_logger_, ss_summary.str());
+    write_log(summary_logger_, summary_sink_, to_string_view(line_buffer_));
   }
   {
-    std::stringstream ss_summary;
-
-    auto invalid_list_size = invalid_list.size();
-    ss_summary << fmt::format("{} Invalid (x2) ({:04}) ", current_time, invalid_list_size);
+    line_buffer_.clear();
+    auto invalid_list_size = invalid_list_.size();
+    fmt::format_to(std::back_inserter(line_buffer_), "{} Invalid (x2) ({:04}) ", current_time, invalid_count);
     if (0 < invalid_list_size && MAX_VALID_LIST_SIZE > invalid_list_size) {
-      ss_summary << fmt::format(":");
-      for (auto&& itr : invalid_list) {
-        ss_summary << fmt::format(" {:04}.{:04}.{:04}|", std::get<0>(itr), std::get<1>(itr), std::get<2>(itr));
+      line_buffer_.push_back(is_keyframe ? ':' : '+');
+      for (auto&& key : invalid_list_) {
+        fmt::format_to(std::back_inserter(line_buffer_), " {:04}.{:04}.{:04}|", key.app_id, key.channel_id,
+                       key.thread_id);
       }
     }
-    write_log(summary_logger_, ss_summary.str());
+    write_log(summary_logger_, summary_sink_, to_string_view(line_buffer_));
   }
   {
-    std::stringstream ss_summary;
-    ss_summary << fmt::format("{} ", current_time);
-    ss_summary << "--------------";
-    write_log(summary_logger_, ss_summary.str());
+    const FpsRollupNode total = rollup_.total();
+    line_buffer_.clear();
+    fmt::format_to(std::back_inserter(line_buffer_), "{} Rollup  (x2) all  ", current_time);
+    format_rollup(line_buffer_, total);
+    write_log(summary_logger_, summary_sink_, to_string_view(line_buffer_));
+    rollup_.apps(rollup_apps_);
+    for (const FpsRollupNode& app : rollup_apps_) {
+      line_buffer_.clear();
+      fmt::format_to(std::back_inserter(line_buffer_), "{} Rollup  (x2) {:04} ", current_time, app.app_id);
+      format_rollup(line_buffer_, app);
+      rollup_.channels(app.app_id, rollup_channels_);
+      if (MAX_VALID_LIST_SIZE > rollup_channels_.size()) {
+        fmt::format_to(std::back_inserter(line_buffer_), " :");
+        for (const FpsRollupNode& channel : rollup_channels_) {
+          fmt::format_to(std::back_inserter(line_buffer_), " {:04} {:.1f}|", channel.channel_id, channel.fps);
+        }
+      }
+      write_log(summary_logger_, summary_sink_, to_string_view(line_buffer_));
+    }
+  }
+  for (const FpsLatencyStats& latency : snapshot_.latencies) {
+    line_buffer_.clear();
+    fmt::format_to(std::back_inserter(line_buffer_), "{} Latency (x2) {:04}.{:04} ms p50/p99 :", current_time,
+                   latency.app_id, latency.channel_id);
+    for (size_t i = 1; i < latency.stages.size(); i++) {
+      const FpsJitterStats& gap = latency.stages[i].from_previous;
+      fmt::format_to(std::back_inserter(line_buffer_), " {:04}>{:04} {:.1f}/{:.1f}|", latency.stages[i - 1].thread_id,
+                     latency.stages[i].thread_id, gap.p50, gap.p99);
+    }
+    if (latency.stages.size() > 2) {
+      const FpsJitterStats& total = latency.stages.back().from_first;
+      fmt::format_to(std::back_inserter(line_buffer_), " all {:.1f}/{:.1f}|", total.p50, total.p99);
+    }
+    write_log(summary_logger_, summary_sink_, to_string_view(line_buffer_));
+  }
+  if (log_self_stats_.load(std::memory_order_relaxed)) {
+    const FpsSelfStats stats = self_stats();
+    line_buffer_.clear();
+    fmt::format_to(std::back_inserter(line_buffer_),
+                   "{} Self    (x2) chn {} reg {} unreg {} reg/s {:.1f} | sample us p50 {} p99 {} max {} | "
+                   "log us p50 {} p99 {} max {} | lock us wait p99 {} max {} hold p99 {} max {} | "
+                   "log {}B {}L summary {}B {}L | batch evict {}",
+                   current_time, stats.channels, stats.registrations, stats.unregistrations, stats.registration_rate,
+                   to_us(stats.sample_pass.quantile_ns(0.5)), to_us(stats.sample_pass.quantile_ns(0.99)),
+                   to_us(stats.sample_pass.max_ns), to_us(stats.log_pass.quantile_ns(0.5)),
+                   to_us(stats.log_pass.quantile_ns(0.99)), to_us(stats.log_pass.max_ns),
+                   to_us(stats.lock_wait.quantile_ns(0.99)), to_us(stats.lock_wait.max_ns),
+                   to_us(stats.lock_hold.quantile_ns(0.99)), to_us(stats.lock_hold.max_ns), stats.log_bytes,
+                   stats.log_lines, stats.summary_bytes, stats.summary_lines, stats.batch_evictions);
+    write_log(summary_logger_, summary_sink_, to_string_view(line_buffer_));
+  }
+  {
+    line_buffer_.clear();
+    fmt::format_to(std::back_inserter(line_buffer_), "{} --------------", current_time);
+    write_log(summary_logger_, summary_sink_, to_string_view(line_buffer_));
+  }
+  // One flush per pass rather than per line.
+  if (logger_) {
+    logger_->flush();
+  }
+  if (summary_logger_) {
+    summary_logger_->flush();
   }
 }
 
-void FpsMonitor::run_() {
-  int sleep_upto_sec = LOG_INTERVAL_SEC;
+void FpsMonitor::sample_(bool close_interval) {
+  const auto start = std::chrono::steady_clock::now();
+  tick_buffers_.flush();
+  calculate_fps_();
+  sample_passes_++;
+  rollup_.update(registry_, health_);
+  take_snapshot_(close_interval);
+  publish_();
+  notify_subscriptions_();
+  health_.check(registry_, sample_passes_, clock_->now_ms(), clock_->wall_ms());
+  rollup_.apply(registry_, health_.transitions());
+  export_();
+  sample_pass_.record(std::chrono::steady_clock::now() - start);
+}
 
-  std::shared_ptr<spdlog::logger> logger_         = get_logger_st(session_dir_, file_name_);
-  std::shared_ptr<spdlog::logger> summary_logger_ = get_logger_st(session_dir_, fmt::format("{}_summary", file_name_));
+void FpsMonitor::check_health_() {
+  // Batched ticks still sitting in producer buffers would otherwise look like a stall.
+  tick_buffers_.flush();
+  health_.check(registry_, sample_passes_, clock_->now_ms(), clock_->wall_ms());
+  rollup_.apply(registry_, health_.transitions());
+}
 
-  auto last_list_size = resource_map_.size();
-  do_write_header_    = true;
+void FpsMonitor::notify_subscriptions_() {
+  if (!has_subscriptions_.load(std::memory_order_acquire)) {
+    return;
+  }
+  std::vector<std::shared_ptr<FpsSubscription>> subscriptions;
+  {
+    const std::lock_guard<std::mutex> lock(subscriptions_mtx_);
+    // A subscription nobody else holds has no reader left.
+    subscriptions_.erase(std::remove_if(subscriptions_.begin(), subscriptions_.end(),
+                                        [](const std::shared_ptr<FpsSubscription>& subscription) {
+                                          return subscription->is_closed() || subscription.use_count() == 1;
+                                        }),
+                         subscriptions_.end());
+    has_subscriptions_.store(!subscriptions_.empty(), std::memory_order_release);
+    subscriptions = subscriptions_;
+  }
+  // One copy per pass, shared by every subscriber; publishing happens outside the lock because BLOCK may wait.
+  const FpsSnapshotPtr snapshot = std::make_shared<const FpsSnapshot>(snapshot_);
+  for (const auto& subscription : subscriptions) {
+    subscription->publish(snapshot);
+  }
+}
+
+void FpsMonitor::close_subscriptions_() {
+  std::vector<std::shared_ptr<FpsSubscription>> subscriptions;
+  {
+    const std::lock_guard<std::mutex> lock(subscriptions_mtx_);
+    subscriptions.swap(subscriptions_);
+    has_subscriptions_.store(false, std::memory_order_release);
+  }
+  for (const auto& subscription : subscriptions) {
+    subscription->close();
+  }
+}
+
+void FpsMonitor::publish_() {
+  if (shm_name_.empty() || is_shm_failed_) {
+    return;
+  }
+  if (!shm_.is_open() && !shm_.open(shm_name_, shm_capacity_)) {
+    is_shm_failed_ = true;
+    return;
+  }
+  shm_.publish(snapshot_);
+}
 
-  while (!do_shutdown_) {
-    if (sleep_upto_sec > 0) {
-      sleep_upto_sec--;
+void FpsMonitor::export_() {
+  if (metrics_endpoint_.empty() || is_exporter_failed_) {
+    return;
+  }
+  if (!exporter_.is_open() && !exporter_.open(metrics_endpoint_)) {
+    is_exporter_failed_ = true;
+    return;
+  }
+  auto out = std::back_inserter(metrics_buffer_);
+  metrics_buffer_.clear();
+  fmt::format_to(out, "# HELP fps_frames_per_second Rate over the last sampling interval.\n"
+                      "# TYPE fps_frames_per_second gauge\n");
+  registry_.for_each([&](const FpsStatus& status) {
+    const FpsKey key = status.key();
+    fmt::format_to(out, "fps_frames_per_second{{app=\"{}\",channel=\"{}\",thread=\"{}\"}} {:.3f}\n", key.app_id,
+                   key.channel_id, key.thread_id, registry_.last_fps(status).load(std::memory_order_relaxed));
+  });
+  fmt::format_to(out, "# HELP fps_ticks_total Ticks counted up to the last sampling pass.\n"
+                      "# TYPE fps_ticks_total counter\n");
+  registry_.for_each([&](const FpsStatus& status) {
+    const FpsKey key = status.key();
+    fmt::format_to(out, "fps_ticks_total{{app=\"{}\",channel=\"{}\",thread=\"{}\"}} {}\n", key.app_id,
+                   key.channel_id, key.thread_id, registry_.sample(status));
+  });
+  fmt::format_to(out, "# HELP fps_health_state 0 unknown, 1 healthy, 2 degraded, 3 stalled.\n"
+                      "# TYPE fps_health_state gauge\n");
+  registry_.for_each([&](const FpsStatus& status) {
+    const FpsKey key = status.key();
+    fmt::format_to(out, "fps_health_state{{app=\"{}\",channel=\"{}\",thread=\"{}\"}} {}\n", key.app_id,
+                   key.channel_id, key.thread_id, static_cast<int>(health_.state(status)));
+  });
+  exporter_.publish(std::string_view(metrics_buffer_.data(), metrics_buffer_.size()));
+}
+
+void FpsMonitor::reconfigure(const FpsMonitorConfig& config) {
+  const std::lock_guard<std::mutex> lock(group_.mtx_);
+  config_.sample_interval     = std::max(config.sample_interval, FpsMonitorConfig::MIN_INTERVAL);
+  config_.log_interval        = std::max(config.log_interval, FpsMonitorConfig::MIN_INTERVAL);
+  config_.idle_ttl            = config.idle_ttl;
+  config_.health_interval     = config.health_interval > std::chrono::milliseconds::zero()
+                                    ? std::max(config.health_interval, FpsMonitorConfig::MIN_INTERVAL)
+                                    : config.health_interval;
+  config_.manual              = config.manual;
+  config_.log_self_stats      = config.log_self_stats;
+  config_.log_epsilon         = config.log_epsilon;
+  config_.log_keyframe_passes = config.log_keyframe_passes;
+  config_.record              = config.record;
+  idle_ttl_ms_                = config.idle_ttl.count();
+  log_self_stats_             = config.log_self_stats;
+  log_epsilon_                = config.log_epsilon;
+  log_keyframe_passes_        = config.log_keyframe_passes;
+  do_record_                  = config.record;
+  do_reschedule_              = true;
+  if (!config_.manual && is_thread_requested_) {
+    group_.start_();
+  }
+  group_.wake_();
+}
+
+auto FpsMonitor::next_deadline_() const -> clock_type::time_point {
+  if (is_closed_) {
+    return clock_type::time_point::max();
+  }
+  if (do_shutdown_) {
+    return clock_type::time_point::min();
+  }
+  if (config_.manual) {
+    return clock_type::time_point::max();
+  }
+  if (!is_started_ || do_reschedule_) {
+    return clock_type::time_point::min();
+  }
+  if (config_.health_interval > std::chrono::milliseconds::zero()) {
+    return std::min({next_sample_, next_log_, next_health_});
+  }
+  return std::min(next_sample_, next_log_);
+}
+
+void FpsMonitor::service_(std::unique_lock<std::mutex>& lock, clock_type::time_point now) {
+  if (is_closed_) {
+    return;
+  }
+  if (do_shutdown_) {
+    lock.unlock();
+    final_pass_();
+    lock.lock();
+    is_closed_ = true;
+    group_.cv_.notify_all();
+    return;
+  }
+  if (config_.manual) {
+    return;
+  }
+  if (!is_started_ || do_reschedule_) {
+    is_started_    = true;
+    do_reschedule_ = false;
+    next_sample_   = now + config_.sample_interval;
+    next_log_      = now + config_.log_interval;
+    next_health_   = now + config_.health_interval;
+    return;
+  }
+
+  const auto health_interval = config_.health_interval;
+  const bool do_sample       = now >= next_sample_;
+  const bool do_log          = now >= next_log_;
+  const bool do_health       = health_interval > std::chrono::milliseconds::zero() && now >= next_health_;
+  if (!do_sample && !do_log && !do_health) {
+    return;
+  }
+  const auto sample_interval = config_.sample_interval;
+  const auto log_interval    = config_.log_interval;
+  lock.unlock();
+
+  if (do_sample || do_log) {
+    sample_(do_log);
+  } else {
+    check_health_();
+  }
+  if (do_log) {
+    log_();
+  }
+
+  lock.lock();
+  while (do_health && next_health_ <= now) {
+    next_health_ += health_interval;
+  }
+  // Deadlines advance on a fixed grid from the start, so pass cost never accumulates as drift; missed slots are
+  // skipped rather than replayed.
+  while (next_sample_ <= now) {
+    next_sample_ += sample_interval;
+  }
+  while (next_log_ <= now) {
+    next_log_ += log_interval;
+  }
+}
+
+void FpsMonitor::open_loggers_() {
+  if (!logger_) {
+    logger_              = get_logger_st(session_dir_, file_name_);
+    summary_logger_      = get_logger_st(session_dir_, fmt::format("{}_summary", file_name_));
+    last_layout_version_ = registry_.layout_version();
+    last_timed_count_    = snapshot_timed_count_;
+    do_write_header_     = true;
+  }
+}
+
+void FpsMonitor::log_() {
+  open_loggers_();
+  // Timing is enabled on a channel in place, without a layout change, yet it adds the jitter columns.
+  if (last_layout_version_ != registry_.layout_version() || last_timed_count_ != snapshot_timed_count_) {
+    last_layout_version_ = registry_.layout_version();
+    last_timed_count_    = snapshot_timed_count_;
+    do_write_header_     = true;
+  }
+  const auto start = std::chrono::steady_clock::now();
+  registry_.for_each([](const FpsStatus& status) {
+    if (FpsRateEstimator* estimator = status.estimator.load(std::memory_order_acquire)) {
+      estimator->close_interval();
+    }
+  });
+  write_data_(logger_, summary_logger_);
+  if (do_record_.load(std::memory_order_relaxed) && !is_record_failed_) {
+    if (!recorder_.is_open() && !recorder_.open(get_record_path(session_dir_, file_name_), max_size, max_files)) {
+      is_record_failed_ = true;
     } else {
-      sleep_upto_sec = LOG_INTERVAL_SEC;
-      {
-        const std::lock_guard<std::mutex> lock(resource_map_mtx_);
-        if (last_list_size != resource_map_.size()) {
-          last_list_size   = resource_map_.size();
-          do_write_header_ = true;
-        }
-      }
-      write_data_(logger_, summary_logger_);
+      recorder_.write(snapshot_);
     }
-    std::this_thread::sleep_for(std::chrono::seconds(1));
   }
+  log_pass_.record(std::chrono::steady_clock::now() - start);
+}
 
-  write_data_(logger_, summary_logger_);
+void FpsMonitor::final_pass_() {
+  // A monitor that never had a channel and never logged leaves no files behind.
+  if (logger_ || is_thread_requested_.load(std::memory_order_relaxed) || registry_.size() != 0) {
+    sample_(true);
+    log_();
+  }
+  shm_.close();
+  exporter_.close();
+  recorder_.close();
+  close_subscriptions_();
+}
+
+void FpsMonitor::step(bool do_log) {
+  sample_(do_log);
+  if (do_log) {
+    log_();
+  }
 }
 
 std::atomic<float>& FpsMonitor::get_fps_(uint64_t app_id, uint64_t channel_id, uint64_t thread_id) {
-  const std::lock_guard<std::mutex> lock(resource_map_mtx_);
+  const FpsKey key{app_id, channel_id, thread_id};
 
-  auto key = std::tuple<uint64_t, uint64_t, uint64_t>(app_id, channel_id, thread_id);
-  auto itr = resource_map_.find(key);
-  if (itr != resource_map_.end()) {
-    return itr->second->last_fps;
+  if (FpsStatus* status = registry_.find(key)) {
+    return registry_.last_fps(*status);
   }
-  auto map = resource_map_.emplace(key, std::move(std::make_unique<FpsStatus>(app_id, channel_id, thread_id, false)));
-  return map.first->second->last_fps;
+  return registry_.last_fps(*insert_(key, false).first);
 }
 
 std::atomic<float>& FpsMonitor::get_fps(uint64_t app_id, uint64_t channel_id, uint64_t thread_id) {
-  return FpsMonitor::getInstance().get_fps_(app_id, channel_id, thread_id);
+  return FpsMonitor::getInstance().fps(app_id, channel_id, thread_id);
+}
+
+int64_t FpsMonitor::get_snapshot_duration_ns() {
+  return FpsMonitor::getInstance().snapshot_duration_ns();
+}
+
+void FpsMonitor::configure(const FpsMonitorConfig& config) { FpsMonitor::getInstance().reconfigure(config); }
+
+FpsSelfStats FpsMonitor::get_self_stats() { return FpsMonitor::getInstance().self_stats(); }
+
+bool FpsMonitor::enable_estimator(uint64_t app_id, uint64_t channel_id, uint64_t thread_id,
+                                  const FpsEstimatorConfig& config) {
+  return FpsMonitor::getInstance().estimate(app_id, channel_id, thread_id, config);
+}
+
+FpsRateStats FpsMonitor::get_rate_stats(uint64_t app_id, uint64_t channel_id, uint64_t thread_id) {
+  return FpsMonitor::getInstance().rate_stats(app_id, channel_id, thread_id);
+}
+
+auto FpsMonitor::estimate(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, const FpsEstimatorConfig& config)
+    -> bool {
+  return acquire_(app_id, channel_id, thread_id, true).enable_estimator(config);
+}
+
+auto FpsMonitor::rate_stats(uint64_t app_id, uint64_t channel_id, uint64_t thread_id) -> FpsRateStats {
+  if (FpsStatus* status = registry_.find(FpsKey{app_id, channel_id, thread_id})) {
+    if (FpsRateEstimator* estimator = status->estimator.load(std::memory_order_acquire)) {
+      return estimator->published();
+    }
+  }
+  return FpsRateStats{};
+}
+
+bool FpsMonitor::enable_timing(uint64_t app_id, uint64_t channel_id, uint64_t thread_id) {
+  return FpsMonitor::getInstance().timing(app_id, channel_id, thread_id);
+}
+
+FpsJitterStats FpsMonitor::get_jitter(uint64_t app_id, uint64_t channel_id, uint64_t thread_id) {
+  return FpsMonitor::getInstance().jitter(app_id, channel_id, thread_id);
+}
+
+FpsHealth& FpsMonitor::get_health() { return FpsMonitor::getInstance().health(); }
+
+const FpsRollup& FpsMonitor::get_rollup() { return FpsMonitor::getInstance().rollup(); }
+
+std::shared_ptr<FpsSubscription> FpsMonitor::subscribe_snapshots(const FpsSubscriptionConfig& config) {
+  return FpsMonitor::getInstance().subscribe(config);
+}
+
+auto FpsMonitor::subscribe(const FpsSubscriptionConfig& config) -> std::shared_ptr<FpsSubscription> {
+  auto                              subscription = std::make_shared<FpsSubscription>(config);
+  const std::lock_guard<std::mutex> lock(subscriptions_mtx_);
+  subscriptions_.push_back(subscription);
+  has_subscriptions_.store(true, std::memory_order_release);
+  return subscription;
+}
+
+bool FpsMonitor::enable_tracing(uint64_t app_id, uint64_t channel_id, const std::vector<uint64_t>& stages) {
+  return FpsMonitor::getInstance().trace(app_id, channel_id, stages);
+}
+
+bool FpsMonitor::disable_tracing(uint64_t app_id, uint64_t channel_id) {
+  return FpsMonitor::getInstance().untrace(app_id, channel_id);
+}
+
+FpsTraceHandle FpsMonitor::get_trace_handle(uint64_t app_id, uint64_t channel_id, uint64_t thread_id) {
+  return FpsMonitor::getInstance().trace_handle(app_id, channel_id, thread_id);
+}
+
+bool FpsMonitor::mark_frame(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, uint64_t frame_id) {
+  return FpsMonitor::getInstance().mark(app_id, channel_id, thread_id, frame_id);
+}
+
+FpsLatencyStats FpsMonitor::get_latency(uint64_t app_id, uint64_t channel_id) {
+  return FpsMonitor::getInstance().latency(app_id, channel_id);
+}
+
+auto FpsMonitor::get_handles(const std::vector<FpsKey>& keys, bool dump_in_log) -> std::vector<FpsHandle> {
+  return FpsMonitor::getInstance().handles(keys, dump_in_log);
+}
+
+void FpsMonitor::reserve_channels(size_t count) { FpsMonitor::getInstance().reserve(count); }
+
+auto FpsMonitor::read_keys(const std::string& path, std::vector<FpsKey>& keys) -> bool {
+  std::ifstream file(path);
+  if (!file) {
+    return false;
+  }
+  std::string line;
+  while (std::getline(file, line)) {
+    const size_t begin = line.find_first_not_of(" \t\r");
+    if (begin == std::string::npos || line[begin] == '#') {
+      continue;
+    }
+    std::istringstream fields(line.substr(begin));
+    FpsKey             key{};
+    char               dot1 = 0;
+    char               dot2 = 0;
+    if (!(fields >> key.app_id >> dot1 >> key.channel_id >> dot2 >> key.thread_id) || dot1 != '.' || dot2 != '.') {
+      return false;
+    }
+    keys.push_back(key);
+  }
+  return true;
+}
+
+auto FpsMonitor::trace(uint64_t app_id, uint64_t channel_id, const std::vector<uint64_t>& stages) -> bool {
+  return tracer_.declare(app_id, channel_id, stages);
+}
+
+auto FpsMonitor::untrace(uint64_t app_id, uint64_t channel_id) -> bool { return tracer_.remove(app_id, channel_id); }
+
+auto FpsMonitor::trace_handle(uint64_t app_id, uint64_t channel_id, uint64_t thread_id) -> FpsTraceHandle {
+  return tracer_.handle(app_id, channel_id, thread_id);
+}
+
+auto FpsMonitor::mark(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, uint64_t frame_id) -> bool {
+  const FpsKey   key{app_id, channel_id, thread_id};
+  TlsTraceEntry& entry = tls_trace_cache[key.hash() % TLS_CACHE_SIZE];
+  // An invalid handle is only looked up again once pipelines were declared or dropped since.
+  if (entry.tracer != &tracer_ || entry.key != key || (!entry.handle.valid() && entry.version != tracer_.version())) {
+    const uint64_t version = tracer_.version();
+    entry                  = TlsTraceEntry{&tracer_, key, tracer_.handle(app_id, channel_id, thread_id), version};
+  }
+  return entry.handle.mark(frame_id);
+}
+
+auto FpsMonitor::latency(uint64_t app_id, uint64_t channel_id) -> FpsLatencyStats {
+  return tracer_.read(app_id, channel_id, false);
+}
+
+size_t FpsMonitor::tick_batch(const FpsTick* ticks, size_t count) {
+  return FpsMonitor::getInstance().batch(ticks, count);
+}
+
+size_t FpsMonitor::tick_batch(const FpsKeyTick* ticks, size_t count, bool dump_in_log) {
+  return FpsMonitor::getInstance().batch(ticks, count, dump_in_log);
+}
+
+auto FpsMonitor::batch(const FpsTick* ticks, size_t count) -> size_t {
+  return tick_buffers_.local().add(ticks, count);
+}
+
+auto FpsMonitor::batch(const FpsKeyTick* ticks, size_t count, bool dump_in_log) -> size_t {
+  std::array<FpsTick, KEY_BATCH_CHUNK> resolved;
+  FpsTickBuffer&                       buffer   = tick_buffers_.local();
+  size_t                               accepted = 0;
+  for (size_t begin = 0; begin < count; begin += KEY_BATCH_CHUNK) {
+    const size_t chunk = std::min(count - begin, KEY_BATCH_CHUNK);
+    for (size_t i = 0; i < chunk; i++) {
+      const FpsKeyTick& tick  = ticks[begin + i]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      TlsCacheEntry&    entry = tls_cache[tick.key.hash() % TLS_CACHE_SIZE];
+      if (entry.registry != &registry_ || entry.key != tick.key || !entry.handle.valid()) {
+        FpsStatus* status = registry_.find(tick.key);
+        if (status == nullptr) {
+          status = insert_(tick.key, dump_in_log).first;
+        }
+        entry = TlsCacheEntry{&registry_, tick.key, FpsHandle{status, status->generation.load()}, &status->counter()};
+      }
+      resolved[i] = FpsTick{entry.handle, tick.count};
+    }
+    accepted += buffer.add(resolved.data(), chunk);
+  }
+  return accepted;
+}
+
+auto FpsMonitor::timing(uint64_t app_id, uint64_t channel_id, uint64_t thread_id) -> bool {
+  return acquire_(app_id, channel_id, thread_id, true).enable_timing();
+}
+
+auto FpsMonitor::jitter(uint64_t app_id, uint64_t channel_id, uint64_t thread_id) -> FpsJitterStats {
+  if (FpsStatus* status = registry_.find(FpsKey{app_id, channel_id, thread_id})) {
+    if (FpsJitter* timing = status->jitter.load(std::memory_order_acquire)) {
+      return timing->read(false);
+    }
+  }
+  return FpsJitterStats{};
+}
+
+auto FpsMonitor::self_stats() const -> FpsSelfStats {
+  FpsSelfStats stats;
+  stats.lock_wait         = registry_.lock_wait();
+  stats.lock_hold         = registry_.lock_hold();
+  stats.sample_pass       = sample_pass_.snapshot();
+  stats.log_pass          = log_pass_.snapshot();
+  stats.log_bytes         = log_sink_.bytes.load(std::memory_order_relaxed);
+  stats.log_lines         = log_sink_.lines.load(std::memory_order_relaxed);
+  stats.summary_bytes     = summary_sink_.bytes.load(std::memory_order_relaxed);
+  stats.summary_lines     = summary_sink_.lines.load(std::memory_order_relaxed);
+  stats.channels          = registry_.live();
+  stats.registrations     = registry_.registrations();
+  stats.unregistrations   = registry_.unregistrations();
+  stats.registration_rate = registration_rate_.load(std::memory_order_relaxed);
+  stats.batch_evictions   = tick_buffers_.evictions();
+  return stats;
+}
+
+auto FpsMonitor::status(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, bool dump_in_log)
+    -> std::atomic_uint_fast64_t& {
+  return set_status_(app_id, channel_id, thread_id, dump_in_log);
+}
+
+auto FpsMonitor::counter(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, bool dump_in_log)
+    -> std::atomic_uint_fast64_t& {
+  return acquire_(app_id, channel_id, thread_id, dump_in_log).counter();
+}
+
+auto FpsMonitor::fps(uint64_t app_id, uint64_t channel_id, uint64_t thread_id) -> std::atomic<float>& {
+  return get_fps_(app_id, channel_id, thread_id);
+}
+
+auto FpsMonitor::handle(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, bool dump_in_log) -> FpsHandle {
+  FpsStatus& status = acquire_(app_id, channel_id, thread_id, dump_in_log);
+  return FpsHandle{&status, status.generation.load(std::memory_order_acquire)};
+}
+
+auto FpsMonitor::handles(const std::vector<FpsKey>& keys, bool dump_in_log) -> std::vector<FpsHandle> {
+  std::vector<FpsStatus*> statuses(keys.size());
+  if (registry_.insert_bulk(keys.data(), keys.size(), dump_in_log, statuses.data()) > 0) {
+    request_thread_();
+  }
+  std::vector<FpsHandle> result;
+  result.reserve(statuses.size());
+  for (FpsStatus* status : statuses) {
+    result.push_back(FpsHandle{status, status->generation.load(std::memory_order_acquire)});
+  }
+  return result;
+}
+
+auto FpsMonitor::remove(uint64_t app_id, uint64_t channel_id, uint64_t thread_id) -> bool {
+  const FpsKey key{app_id, channel_id, thread_id};
+  if (!registry_.remove(key)) {
+    return false;
+  }
+  tracer_.remove(key);
+  return true;
+}
+
+auto FpsMonitor::stripe(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, size_t stripe_count) -> bool {
+  return acquire_(app_id, channel_id, thread_id, true).enable_striping(stripe_count);
 }
 
 void set_status(uint64_t app_id, uint64_t channel_id, uint64_t thread_id) {
   return FpsMonitor::set_status_reference(app_id, channel_id, thread_id);
 }
+
+fps_handle_t fps_acquire(uint64_t app_id, uint64_t channel_id, uint64_t thread_id) {
+  static_assert(sizeof(std::atomic_uint_fast64_t) == sizeof(uint64_t) && std::atomic_uint_fast64_t::is_always_lock_free,
+                "fps_tick expects a plain lock-free 64 bit counter");
+  static_assert(sizeof(std::atomic_uint32_t) == sizeof(uint32_t) && std::atomic_uint32_t::is_always_lock_free,
+                "fps_tick expects a plain lock-free 32 bit generation");
+  FpsHandle handle = FpsMonitor::get_handle(app_id, channel_id, thread_id);
+  // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+  return fps_handle_t{reinterpret_cast<uint64_t*>(&handle.status->counter()),
+                      reinterpret_cast<const uint32_t*>(&handle.status->generation), handle.generation,
+                      handle.status->jitter.load(std::memory_order_acquire)};
+  // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+int fps_unregister(uint64_t app_id, uint64_t channel_id, uint64_t thread_id) {
+  return FpsMonitor::unregister(app_id, channel_id, thread_id) ? 1 : 0;
+}
+
+int fps_enable_striping(uint64_t app_id, uint64_t channel_id, uint64_t thread_id, uint32_t stripe_count) {
+  return FpsMonitor::enable_striping(app_id, channel_id, thread_id, stripe_count) ? 1 : 0;
+}
+
+int fps_enable_timing(uint64_t app_id, uint64_t channel_id, uint64_t thread_id) {
+  return FpsMonitor::enable_timing(app_id, channel_id, thread_id) ? 1 : 0;
+}
+
+void fps_record_arrival(void* timing) { static_cast<FpsJitter*>(timing)->record(); }
@@ -0,0 +1,113 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#include "fps_monitor_group.h"
+
+#include <algorithm>
+#include <chrono>
+#include <spdlog/details/registry.h>
+#include <utility>
+#include <vector>
+
+FpsMonitorGroup::~FpsMonitorGroup() { close(); }
+
+auto FpsMonitorGroup::getInstance() -> FpsMonitorGroup& {
+  // Construct spdlog's registry first so it outlives the group, whose destructor writes every monitor's final pass.
+  spdlog::details::registry::instance();
+  static FpsMonitorGroup instance;
+  return instance;
+}
+
+void FpsMonitorGroup::wake_() {
+  do_wake_ = true;
+  cv_.notify_all();
+}
+
+void FpsMonitorGroup::start_() {
+  if (!thread_) {
+    do_stop_    = false;
+    is_running_ = true;
+    thread_     = std::make_unique<std::thread>(&FpsMonitorGroup::run_, this);
+  }
+  wake_();
+}
+
+auto FpsMonitorGroup::create(const std::string& name, std::string session_dir, std::string file_name,
+                             const FpsMonitorConfig& config) -> FpsMonitor& {
+  const std::lock_guard<std::mutex> lock(mtx_);
+  auto                              itr = monitors_.find(name);
+  if (itr != monitors_.end()) {
+    return *itr->second;
+  }
+  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+  auto monitor = std::unique_ptr<FpsMonitor>(
+      new FpsMonitor(*this, name, std::move(session_dir), std::move(file_name), config));
+  FpsMonitor& ref = *monitor;
+  monitors_.emplace(name, std::move(monitor));
+  return ref;
+}
+
+auto FpsMonitorGroup::get(const std::string& name) -> FpsMonitor* {
+  const std::lock_guard<std::mutex> lock(mtx_);
+  auto                              itr = monitors_.find(name);
+  return itr != monitors_.end() ? itr->second.get() : nullptr;
+}
+
+void FpsMonitorGroup::close() {
+  {
+    const std::lock_guard<std::mutex> lock(mtx_);
+    for (auto&& itr : monitors_) {
+      itr.second->do_shutdown_ = true;
+    }
+    do_stop_ = true;
+    wake_();
+  }
+  if (thread_) {
+    thread_->join();
+    thread_ = nullptr;
+  }
+  // Monitors the thread never served still owe their final pass.
+  std::vector<FpsMonitor*> pending;
+  {
+    const std::lock_guard<std::mutex> lock(mtx_);
+    for (auto&& itr : monitors_) {
+      pending.push_back(itr.second.get());
+    }
+  }
+  for (FpsMonitor* monitor : pending) {
+    monitor->shutDown();
+  }
+}
+
+void FpsMonitorGroup::run_() {
+  using clock_type = std::chrono::steady_clock;
+
+  std::unique_lock<std::mutex> lock(mtx_);
+  while (true) {
+    auto deadline = clock_type::time_point::max();
+    for (auto&& itr : monitors_) {
+      deadline = std::min(deadline, itr.second->next_deadline_());
+    }
+    const auto woken = [&] { return do_wake_ || do_stop_; };
+    if (deadline == clock_type::time_point::max()) {
+      cv_.wait(lock, woken);
+    } else {
+      cv_.wait_until(lock, deadline, woken);
+    }
+    do_wake_ = false;
+
+    const auto now = clock_type::now();
+    // std::map iterators survive concurrent inserts while service_ drops the lock around a pass.
+    for (auto&& itr : monitors_) {
+      itr.second->service_(lock, now);
+    }
+
+    if (do_stop_ && std::all_of(monitors_.begin(), monitors_.end(),
+                                [](const auto& itr) { return itr.second->is_closed_; })) {
+      break;
+    }
+  }
+  is_running_ = false;
+  cv_.notify_all();
+}
@@ -0,0 +1,159 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#include "fps_recorder.h"
+#include <charconv>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <fmt/chrono.h>
+#include <fmt/core.h>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Reads .fpsr recordings and prints them as CSV or in the text log layout.
+// Usage: fpsrec [--text] [--channel app.chn.thr]... [--from ms] [--to ms] file...
+// Files are read in the order given, so pass rotated files oldest first (name.2.fpsr name.1.fpsr name.fpsr).
+
+namespace {
+constexpr int64_t MILLI_SECONDS_IN_SECONDS = 1000;
+
+struct Options {
+  bool                     as_text{false};
+  std::vector<FpsKey>      channels;
+  int64_t                  from{INT64_MIN};
+  int64_t                  to{INT64_MAX};
+  std::vector<std::string> files;
+};
+
+bool parse_key(const std::string& text, FpsKey& key) {
+  unsigned long long app_id     = 0;
+  unsigned long long channel_id = 0;
+  unsigned long long thread_id  = 0;
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,cert-err34-c)
+  if (std::sscanf(text.c_str(), "%llu.%llu.%llu", &app_id, &channel_id, &thread_id) != 3) {
+    return false;
+  }
+  key = FpsKey{app_id, channel_id, thread_id};
+  return true;
+}
+
+bool parse_ms(const std::string& text, int64_t& ms) {
+  const char* end    = text.data() + text.size(); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  const auto  result = std::from_chars(text.data(), end, ms);
+  return result.ec == std::errc() && result.ptr == end;
+}
+
+void print_usage(const std::string& name) {
+  fmt::print(stderr, "usage: {} [--text] [--channel app.chn.thr]... [--from ms] [--to ms] file...\n", name);
+}
+
+bool selected(const Options& options, const FpsKey& key) {
+  if (options.channels.empty()) {
+    return true;
+  }
+  for (auto&& channel : options.channels) {
+    if (channel == key) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void print_csv(const FpsSnapshot& snapshot, const Options& options) {
+  for (auto&& sample : snapshot.samples) {
+    if (selected(options, sample.key)) {
+      fmt::print("{},{},{},{},{},{:.2f}\n", snapshot.ts, sample.key.app_id, sample.key.channel_id,
+                 sample.key.thread_id, sample.value, sample.fps);
+    }
+  }
+}
+
+// Same layout as FpsMonitor::write_data_, with the header repeated whenever the set of channels changes.
+void print_text(const FpsSnapshot& snapshot, const Options& options, std::vector<FpsKey>& last_keys) {
+  std::vector<FpsKey> keys;
+  for (auto&& sample : snapshot.samples) {
+    if (selected(options, sample.key)) {
+      keys.push_back(sample.key);
+    }
+  }
+  if (keys.empty()) {
+    return;
+  }
+  const std::time_t  time = static_cast<std::time_t>(snapshot.ts / MILLI_SECONDS_IN_SECONDS);
+  fmt::memory_buffer line;
+  if (keys != last_keys) {
+    for (size_t i = 0; i < keys.size(); i++) {
+      fmt::format_to(std::back_inserter(line), "Time     App .Chn .Thr        Fps|");
+    }
+    fmt::print("{:%Y-%m-%d}\n{}\n", fmt::localtime(time), fmt::to_string(line));
+    line.clear();
+    last_keys = keys;
+  }
+  for (auto&& sample : snapshot.samples) {
+    if (selected(options, sample.key)) {
+      fmt::format_to(std::back_inserter(line), "{:%H:%M:%S} {:04}.{:04}.{:04} {:>9.1f}|", fmt::localtime(time),
+                     sample.key.app_id, sample.key.channel_id, sample.key.thread_id, sample.fps);
+    }
+  }
+  fmt::print("{}\n", fmt::to_string(line));
+}
+} // namespace
+
+auto main(int argc, char const* argv[]) -> int {
+  const std::vector<std::string> args(argv, argv + argc);
+  Options                        options;
+  for (size_t i = 1; i < args.size(); i++) {
+    const bool has_value = i + 1 < args.size();
+    if (args[i] == "--text") {
+      options.as_text = true;
+    } else if (args[i] == "--channel" && has_value) {
+      FpsKey key;
+      if (!parse_key(args[++i], key)) {
+        fmt::print(stderr, "bad channel {}, expected app.chn.thr\n", args[i]);
+        return 2;
+      }
+      options.channels.push_back(key);
+    } else if ((args[i] == "--from" || args[i] == "--to") && has_value) {
+      const std::string& option = args[i];
+      if (!parse_ms(args[++i], option == "--from" ? options.from : options.to)) {
+        fmt::print(stderr, "bad {} {}, expected milliseconds\n", option, args[i]);
+        print_usage(args[0]);
+        return 2;
+      }
+    } else {
+      options.files.push_back(args[i]);
+    }
+  }
+  if (options.files.empty()) {
+    print_usage(args[0]);
+    return 2;
+  }
+
+  if (!options.as_text) {
+    fmt::print("ts,app,channel,thread,value,fps\n");
+  }
+  FpsRecordReader     reader;
+  FpsSnapshot         snapshot;
+  std::vector<FpsKey> last_keys;
+  for (auto&& file : options.files) {
+    if (!reader.open(file)) {
+      fmt::print(stderr, "cannot read recording {}\n", file);
+      return 1;
+    }
+    while (reader.next(snapshot)) {
+      if (snapshot.ts < options.from || snapshot.ts > options.to) {
+        continue;
+      }
+      if (options.as_text) {
+        print_text(snapshot, options, last_keys);
+      } else {
+        print_csv(snapshot, options);
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,324 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#include "fps_recorder.h"
+
+#include <array>
+#include <cmath>
+#include <utility>
+
+namespace {
+constexpr uint8_t RECORD_DICTIONARY = 1;
+constexpr uint8_t RECORD_FRAME      = 2;
+constexpr float   CENTI             = 100.0F;
+constexpr size_t  MAX_RECORD_SIZE   = 1U << 30U;
+
+void put_varint(std::vector<uint8_t>& out, uint64_t value) {
+  // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+  while (value >= 0x80U) {
+    out.push_back(static_cast<uint8_t>(value | 0x80U));
+    value >>= 7U;
+  }
+  // NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+  out.push_back(static_cast<uint8_t>(value));
+}
+void put_zigzag(std::vector<uint8_t>& out, int64_t value) {
+  put_varint(out, (static_cast<uint64_t>(value) << 1U) ^ static_cast<uint64_t>(value >> 63)); // NOLINT
+}
+
+// Bounds-checked cursor over a record payload.
+class Cursor {
+private:
+  const std::vector<uint8_t>& data_;
+  size_t                      pos_{0};
+  bool                        is_ok_{true};
+
+public:
+  explicit Cursor(const std::vector<uint8_t>& data) : data_(data) {}
+  bool     ok() const { return is_ok_; }
+  uint64_t varint() {
+    uint64_t value = 0;
+    // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+      if (pos_ >= data_.size()) {
+        is_ok_ = false;
+        return 0;
+      }
+      const uint8_t byte = data_[pos_++];
+      value |= static_cast<uint64_t>(byte & 0x7fU) << shift;
+      if ((byte & 0x80U) == 0) {
+        return value;
+      }
+    }
+    // NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+    is_ok_ = false;
+    return 0;
+  }
+  int64_t zigzag() {
+    const uint64_t value = varint();
+    return static_cast<int64_t>(value >> 1U) ^ -static_cast<int64_t>(value & 1U);
+  }
+};
+
+bool read_varint(std::FILE* file, uint64_t& value) {
+  value = 0;
+  // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+  for (unsigned shift = 0; shift < 64; shift += 7) {
+    const int byte = std::fgetc(file);
+    if (byte == EOF) {
+      return false;
+    }
+    value |= static_cast<uint64_t>(static_cast<unsigned>(byte) & 0x7fU) << shift;
+    if ((static_cast<unsigned>(byte) & 0x80U) == 0) {
+      return true;
+    }
+  }
+  // NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+  return false;
+}
+
+std::array<uint8_t, 8> file_header() {
+  std::array<uint8_t, 8> header{};
+  for (size_t i = 0; i < 4; i++) {
+    header[i]     = static_cast<uint8_t>(FPS_RECORD_MAGIC >> (8 * i));   // NOLINT
+    header[i + 4] = static_cast<uint8_t>(FPS_RECORD_VERSION >> (8 * i)); // NOLINT
+  }
+  return header;
+}
+
+// "dir/name.fpsr" -> "dir/name.<index>.fpsr", like the rotating text logs.
+std::string rotated_name(const std::string& path, size_t index) {
+  if (index == 0) {
+    return path;
+  }
+  const size_t dot   = path.rfind('.');
+  const size_t slash = path.find_last_of("/\\");
+  if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+    return path + "." + std::to_string(index);
+  }
+  return path.substr(0, dot) + "." + std::to_string(index) + path.substr(dot);
+}
+} // namespace
+
+bool FpsRecorder::open(std::string path, size_t max_size, size_t max_files) {
+  close();
+  path_      = std::move(path);
+  max_size_  = max_size;
+  max_files_ = max_files;
+  // A recording left by an earlier run moves into the rotation instead of being truncated.
+  if (std::FILE* existing = std::fopen(path_.c_str(), "rb")) { // NOLINT(cppcoreguidelines-owning-memory)
+    const bool has_frames = std::fseek(existing, 0, SEEK_END) == 0 &&
+                            std::ftell(existing) > static_cast<long>(file_header().size()); // NOLINT(google-runtime-int)
+    std::fclose(existing); // NOLINT(cppcoreguidelines-owning-memory)
+    if (has_frames) {
+      shift_files_();
+    }
+  }
+  return open_file_();
+}
+
+bool FpsRecorder::open_file_() {
+  file_ = std::fopen(path_.c_str(), "wb"); // NOLINT(cppcoreguidelines-owning-memory)
+  if (file_ == nullptr) {
+    return false;
+  }
+  const auto header = file_header();
+  std::fwrite(header.data(), 1, header.size(), file_);
+  std::fflush(file_);
+  file_size_ = header.size();
+  last_ts_   = 0;
+  ids_.clear();
+  keys_.clear();
+  channels_.clear();
+  return true;
+}
+
+void FpsRecorder::shift_files_() {
+  for (size_t i = max_files_; i > 0; i--) {
+    const std::string target = rotated_name(path_, i);
+    std::remove(target.c_str());
+    std::rename(rotated_name(path_, i - 1).c_str(), target.c_str());
+  }
+}
+
+void FpsRecorder::rotate_() {
+  std::fclose(file_); // NOLINT(cppcoreguidelines-owning-memory)
+  file_ = nullptr;
+  shift_files_();
+  open_file_();
+}
+
+uint32_t FpsRecorder::id_(const FpsKey& key) {
+  auto found = ids_.find(key);
+  if (found != ids_.end()) {
+    return found->second;
+  }
+  const auto id = static_cast<uint32_t>(keys_.size());
+  ids_.emplace(key, id);
+  keys_.push_back(key);
+  channels_.emplace_back();
+  put_varint(dictionary_, key.app_id);
+  put_varint(dictionary_, key.channel_id);
+  put_varint(dictionary_, key.thread_id);
+  return id;
+}
+
+void FpsRecorder::write_record_(uint8_t type, const std::vector<uint8_t>& payload) {
+  std::array<uint8_t, 1> type_byte{type};
+  std::vector<uint8_t>   length;
+  put_varint(length, payload.size());
+  std::fwrite(type_byte.data(), 1, type_byte.size(), file_);
+  std::fwrite(length.data(), 1, length.size(), file_);
+  std::fwrite(payload.data(), 1, payload.size(), file_);
+  file_size_ += type_byte.size() + length.size() + payload.size();
+}
+
+void FpsRecorder::write(const FpsSnapshot& snapshot) {
+  if (file_ == nullptr) {
+    return;
+  }
+  if (file_size_ >= max_size_) {
+    rotate_();
+    if (file_ == nullptr) {
+      return;
+    }
+  }
+
+  dictionary_.clear();
+  frame_.clear();
+  const size_t first_new = keys_.size();
+  for (auto&& sample : snapshot.samples) {
+    if (sample.dump_in_log) {
+      frame_.emplace_back(id_(sample.key), &sample);
+    }
+  }
+  if (keys_.size() != first_new) {
+    payload_.clear();
+    put_varint(payload_, first_new);
+    put_varint(payload_, keys_.size() - first_new);
+    payload_.insert(payload_.end(), dictionary_.begin(), dictionary_.end());
+    write_record_(RECORD_DICTIONARY, payload_);
+  }
+
+  payload_.clear();
+  put_zigzag(payload_, snapshot.ts - last_ts_);
+  put_varint(payload_, frame_.size());
+  int64_t last_id = 0;
+  for (auto&& entry : frame_) {
+    put_zigzag(payload_, static_cast<int64_t>(entry.first) - last_id);
+    last_id = entry.first;
+  }
+  for (auto&& entry : frame_) {
+    Channel& channel = channels_[entry.first];
+    put_zigzag(payload_, static_cast<int64_t>(entry.second->value - channel.value));
+    channel.value = entry.second->value;
+  }
+  for (auto&& entry : frame_) {
+    Channel&      channel   = channels_[entry.first];
+    const int64_t centi_fps = std::llround(entry.second->fps * CENTI);
+    put_zigzag(payload_, centi_fps - channel.centi_fps);
+    channel.centi_fps = centi_fps;
+  }
+  write_record_(RECORD_FRAME, payload_);
+  last_ts_ = snapshot.ts;
+  // Flushed per frame so a crash loses at most the pass in flight.
+  std::fflush(file_);
+}
+
+void FpsRecorder::close() {
+  if (file_ != nullptr) {
+    std::fclose(file_); // NOLINT(cppcoreguidelines-owning-memory)
+    file_ = nullptr;
+  }
+}
+
+bool FpsRecordReader::open(const std::string& path) {
+  close();
+  file_ = std::fopen(path.c_str(), "rb"); // NOLINT(cppcoreguidelines-owning-memory)
+  if (file_ == nullptr) {
+    return false;
+  }
+  std::array<uint8_t, 8> header{};
+  if (std::fread(header.data(), 1, header.size(), file_) != header.size() || header != file_header()) {
+    close();
+    return false;
+  }
+  last_ts_ = 0;
+  keys_.clear();
+  channels_.clear();
+  return true;
+}
+
+bool FpsRecordReader::next(FpsSnapshot& snapshot) {
+  while (file_ != nullptr) {
+    const int type = std::fgetc(file_);
+    uint64_t  size = 0;
+    if (type == EOF || !read_varint(file_, size) || size > MAX_RECORD_SIZE) {
+      return false;
+    }
+    payload_.resize(size);
+    if (std::fread(payload_.data(), 1, size, file_) != size) {
+      return false;
+    }
+
+    Cursor cursor(payload_);
+    if (type == RECORD_DICTIONARY) {
+      const uint64_t first = cursor.varint();
+      const uint64_t count = cursor.varint();
+      if (!cursor.ok() || first != keys_.size() || count > size) {
+        return false;
+      }
+      for (uint64_t i = 0; i < count; i++) {
+        FpsKey key;
+        key.app_id     = cursor.varint();
+        key.channel_id = cursor.varint();
+        key.thread_id  = cursor.varint();
+        keys_.push_back(key);
+        channels_.emplace_back();
+      }
+      if (!cursor.ok()) {
+        return false;
+      }
+    } else if (type == RECORD_FRAME) {
+      last_ts_ += cursor.zigzag();
+      const uint64_t count = cursor.varint();
+      if (!cursor.ok() || count > size) {
+        return false;
+      }
+      snapshot.ts = last_ts_;
+      snapshot.samples.resize(count);
+      frame_ids_.resize(count);
+      int64_t id = 0;
+      for (size_t i = 0; i < count; i++) {
+        id += cursor.zigzag();
+        if (id < 0 || static_cast<size_t>(id) >= keys_.size()) {
+          return false;
+        }
+        frame_ids_[i] = static_cast<uint32_t>(id);
+      }
+      for (size_t i = 0; i < count; i++) {
+        channels_[frame_ids_[i]].value += static_cast<uint64_t>(cursor.zigzag());
+      }
+      for (size_t i = 0; i < count; i++) {
+        Channel& channel = channels_[frame_ids_[i]];
+        channel.centi_fps += cursor.zigzag();
+        FpsSample& sample  = snapshot.samples[i];
+        sample.key         = keys_[frame_ids_[i]];
+        sample.value       = channel.value;
+        sample.fps         = static_cast<float>(channel.centi_fps) / CENTI;
+        sample.dump_in_log = true;
+      }
+      return cursor.ok();
+    }
+    // Unknown record types are skipped so newer writers stay readable.
+  }
+  return false;
+}
+
+void FpsRecordReader::close() {
+  if (file_ != nullptr) {
+    std::fclose(file_); // NOLINT(cppcoreguidelines-owning-memory)
+    file_ = nullptr;
+  }
+}
@@ -0,0 +1,238 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#include "fps_registry.h"
+
+#include <algorithm>
+
+namespace {
+// Shard selection uses the low bits of the hash, probing starts from the high bits.
+constexpr uint32_t PROBE_SHIFT = 32;
+} // namespace
+
+FpsStatus FpsRegistry::tombstone_;
+
+FpsRegistry::Table::Table(size_t capacity)
+    : mask(capacity - 1), slots(std::make_unique<std::atomic<FpsStatus*>[]>(capacity)) { // NOLINT
+  for (size_t i = 0; i < capacity; i++) {
+    slots[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+FpsRegistry::FpsRegistry() {
+  for (auto&& shard : shards_) {
+    shard.current = std::make_unique<Table>(INITIAL_CAPACITY);
+    shard.table.store(shard.current.get(), std::memory_order_release);
+  }
+}
+
+FpsRegistry::~FpsRegistry() = default;
+
+FpsStatus* FpsRegistry::probe_(const Table* table, const FpsKey& key, uint64_t hash) {
+  size_t index = (hash >> PROBE_SHIFT) & table->mask;
+  for (size_t i = 0; i <= table->mask; i++) {
+    FpsStatus* status = table->slots[index].load(std::memory_order_acquire);
+    if (status == nullptr) {
+      return nullptr;
+    }
+    // A retired table may still point at a cell that was unregistered or even reused since, so the key is only
+    // trusted if the cell was live and kept the same generation across the read.
+    if (status != &tombstone_) {
+      const uint32_t generation = status->generation.load(std::memory_order_acquire);
+      if ((generation & 1U) == 0 && status->key() == key) {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (status->generation.load(std::memory_order_relaxed) == generation) {
+          return status;
+        }
+      }
+    }
+    index = (index + 1) & table->mask;
+  }
+  return nullptr;
+}
+
+void FpsRegistry::place_(Table* table, FpsStatus* status, uint64_t hash) {
+  size_t index = (hash >> PROBE_SHIFT) & table->mask;
+  while (table->slots[index].load(std::memory_order_relaxed) != nullptr) {
+    index = (index + 1) & table->mask;
+  }
+  table->slots[index].store(status, std::memory_order_release);
+}
+
+FpsStatus* FpsRegistry::find(const FpsKey& key) const {
+  const uint64_t hash = key.hash();
+  return probe_(shard_(hash).table.load(std::memory_order_acquire), key, hash);
+}
+
+std::pair<FpsStatus*, bool> FpsRegistry::find_or_insert(const FpsKey& key, bool dump_in_log) {
+  const uint64_t hash  = key.hash();
+  Shard&         shard = shard_(hash);
+  if (FpsStatus* status = probe_(shard.table.load(std::memory_order_acquire), key, hash)) {
+    return {status, false};
+  }
+
+  const FpsTimedLock lock(shard.insert_mtx, lock_wait_, lock_hold_);
+  if (FpsStatus* status = probe_(shard.table.load(std::memory_order_relaxed), key, hash)) {
+    return {status, false};
+  }
+
+  Table*     table  = make_room_(shard, 1);
+  FpsStatus& status = slab_.append(key, dump_in_log);
+  place_(table, &status, hash);
+  shard.count++;
+  registrations_.fetch_add(1, std::memory_order_relaxed);
+  return {&status, true};
+}
+
+void FpsRegistry::reserve(size_t count) {
+  slab_.reserve(count);
+  // The hash spreads keys evenly enough that the table's own headroom absorbs the skew between shards.
+  const size_t per_shard = count / SHARD_COUNT + 1;
+  for (auto&& shard : shards_) {
+    const FpsTimedLock lock(shard.insert_mtx, lock_wait_, lock_hold_);
+    make_room_(shard, per_shard);
+  }
+}
+
+size_t FpsRegistry::insert_bulk(const FpsKey* keys, size_t count, bool dump_in_log, FpsStatus** out) {
+  reserve(count);
+  // Bucket the keys by shard so each shard is locked once.
+  std::vector<uint64_t>               hashes(count);
+  std::array<size_t, SHARD_COUNT + 1> starts{};
+  std::vector<uint32_t>               order(count);
+  for (size_t i = 0; i < count; i++) {
+    hashes[i] = keys[i].hash(); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    starts[hashes[i] % SHARD_COUNT + 1]++;
+  }
+  for (size_t i = 0; i < SHARD_COUNT; i++) {
+    starts[i + 1] += starts[i];
+  }
+  std::array<size_t, SHARD_COUNT> next{};
+  std::copy(starts.begin(), starts.end() - 1, next.begin());
+  for (size_t i = 0; i < count; i++) {
+    order[next[hashes[i] % SHARD_COUNT]++] = static_cast<uint32_t>(i);
+  }
+
+  size_t inserted = 0;
+  for (size_t s = 0; s < SHARD_COUNT; s++) {
+    if (starts[s] == starts[s + 1]) {
+      continue;
+    }
+    Shard&             shard = shards_[s];
+    const FpsTimedLock lock(shard.insert_mtx, lock_wait_, lock_hold_);
+    for (size_t j = starts[s]; j < starts[s + 1]; j++) {
+      const uint32_t i      = order[j];
+      const FpsKey&  key    = keys[i]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      FpsStatus*     status = probe_(shard.table.load(std::memory_order_relaxed), key, hashes[i]);
+      if (status == nullptr) {
+        Table* table = make_room_(shard, 1);
+        status       = &slab_.append(key, dump_in_log);
+        place_(table, status, hashes[i]);
+        shard.count++;
+        inserted++;
+      }
+      out[i] = status; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+  }
+  registrations_.fetch_add(inserted, std::memory_order_relaxed);
+  return inserted;
+}
+
+auto FpsRegistry::make_room_(Shard& shard, size_t extra) -> Table* {
+  // Keep the load factor, tombstones included, at or below one half so probes stay short and always hit an empty slot.
+  Table* table = shard.table.load(std::memory_order_relaxed);
+  if ((shard.count + extra) * 2 <= table->mask + 1) {
+    return table;
+  }
+  size_t live = 0;
+  for (size_t i = 0; i <= table->mask; i++) {
+    FpsStatus* status = table->slots[i].load(std::memory_order_relaxed);
+    live += (status != nullptr && status != &tombstone_) ? 1 : 0;
+  }
+  return rebuild_(shard, live, extra);
+}
+
+auto FpsRegistry::rebuild_(Shard& shard, size_t live, size_t extra) -> Table* {
+  Table* table    = shard.table.load(std::memory_order_relaxed);
+  size_t capacity = INITIAL_CAPACITY;
+  while ((live + extra) * 4 > capacity) {
+    capacity *= 2;
+  }
+  auto rebuilt = std::make_unique<Table>(capacity);
+  for (size_t i = 0; i <= table->mask; i++) {
+    FpsStatus* status = table->slots[i].load(std::memory_order_relaxed);
+    if (status != nullptr && status != &tombstone_) {
+      place_(rebuilt.get(), status, status->key().hash());
+    }
+  }
+  // Readers may still be probing the old table, so it is retired and freed by a later sampling pass.
+  shard.count = live;
+  shard.table.store(rebuilt.get(), std::memory_order_release);
+  shard.retired.push_back(RetiredTable{std::move(shard.current), slab_.passes()});
+  shard.current = std::move(rebuilt);
+  retired_tables_.fetch_add(1, std::memory_order_relaxed);
+  return shard.current.get();
+}
+
+void FpsRegistry::reclaim_tables_() {
+  const uint64_t pass  = slab_.passes();
+  size_t         freed = 0;
+  for (auto&& shard : shards_) {
+    const std::lock_guard<std::mutex> lock(shard.insert_mtx);
+    auto                              itr = shard.retired.begin();
+    while (itr != shard.retired.end() && pass - itr->pass >= FPS_RECLAIM_PASSES) {
+      ++itr;
+    }
+    freed += static_cast<size_t>(itr - shard.retired.begin());
+    shard.retired.erase(shard.retired.begin(), itr);
+  }
+  retired_tables_.fetch_sub(freed, std::memory_order_relaxed);
+}
+
+void FpsRegistry::compute_rates(int64_t time_diff_ms, int64_t now_ms) {
+  slab_.compute_rates(time_diff_ms, now_ms);
+  if (retired_tables_.load(std::memory_order_relaxed) != 0) {
+    reclaim_tables_();
+  }
+}
+
+bool FpsRegistry::remove(const FpsKey& key) {
+  const uint64_t     hash  = key.hash();
+  Shard&             shard = shard_(hash);
+  const FpsTimedLock lock(shard.insert_mtx, lock_wait_, lock_hold_);
+  Table*             table = shard.table.load(std::memory_order_relaxed);
+
+  size_t index = (hash >> PROBE_SHIFT) & table->mask;
+  for (size_t i = 0; i <= table->mask; i++) {
+    FpsStatus* status = table->slots[index].load(std::memory_order_relaxed);
+    if (status == nullptr) {
+      return false;
+    }
+    if (status != &tombstone_ && status->key() == key) {
+      table->slots[index].store(&tombstone_, std::memory_order_release);
+      slab_.retire(*status);
+      unregistrations_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+    index = (index + 1) & table->mask;
+  }
+  return false;
+}
+
+size_t FpsRegistry::evict_idle(int64_t now_ms, int64_t ttl_ms, std::vector<FpsKey>* keys) {
+  size_t       evicted = 0;
+  const size_t count   = size();
+  for (size_t i = 0; i < count; i++) {
+    FpsStatus&    status      = at(i);
+    const int64_t last_change = slab_.last_change(i);
+    const FpsKey  key         = status.key();
+    if (status.is_live() && last_change != 0 && now_ms - last_change > ttl_ms && remove(key)) {
+      evicted++;
+      if (keys != nullptr) {
+        keys->push_back(key);
+      }
+    }
+  }
+  return evicted;
+}
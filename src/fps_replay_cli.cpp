@@ -0,0 +1,333 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#include "fps_monitor.h"
+#include "fps_monitor_group.h"
+#include "fps_recorder.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fmt/core.h>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Drives a manual FpsMonitor from an FpsVirtualClock, so hours of load replay in seconds. Checks every computed rate
+// against the ticks fed in, and the final Valid count in the summary log against the health rule. Synthetic channels
+// also carry a rate estimator whose window rate is checked the same way while passes are at least a window long.
+// Usage: fpsreplay [--channels n] [--fps f] [--slow-every k] [--slow-fps f] [--seconds s] [--tick-ms ms]
+//                  [--sample-ms ms] [--log-ms ms] [--log-epsilon f] [--tolerance f] [--session dir] [recording...]
+// Without recordings the trace is synthetic: every channel ticks at --fps, every k-th one at --slow-fps. Recordings
+// (.fpsr, oldest first) replay one sampling pass per recorded pass, with the ticks taken from the recorded totals.
+
+namespace {
+constexpr int64_t     MILLI_SECONDS_IN_SECOND      = 1000;
+constexpr int64_t     NANO_SECONDS_IN_MILLI_SECOND = 1000000;
+constexpr size_t      MAX_REPORTED_FAILURES        = 10;
+constexpr const char* MONITOR_NAME                 = "replay";
+constexpr const char* VALID_TAG                    = " Valid   (x2) (";
+
+struct Options {
+  uint64_t                 channels{5000};
+  double                   fps{25.0};
+  uint64_t                 slow_every{0};
+  double                   slow_fps{5.0};
+  int64_t                  seconds{3600};
+  int64_t                  tick_ms{1000};
+  int64_t                  sample_ms{10000};
+  int64_t                  log_ms{10000};
+  float                    log_epsilon{0.0};
+  double                   tolerance{0.01};
+  std::string              session_dir{"replay"};
+  std::vector<std::string> recordings;
+};
+
+struct Channel {
+  FpsKey    key;
+  FpsHandle handle;
+  double    fps{0.0};
+  double    owed{0.0};     // fractional frames carried to the next tick
+  uint64_t  total{0};      // recorded total, when replaying a recording
+  uint64_t  ticks{0};      // fed since the last sampling pass
+  double    expected{0.0}; // rate implied by the last pass
+  bool      is_present{false};
+};
+
+struct KeyHash {
+  size_t operator()(const FpsKey& key) const { return static_cast<size_t>(key.hash()); }
+};
+
+struct Result {
+  uint64_t passes{0};
+  uint64_t checked{0};
+  uint64_t failures{0};
+  double   max_error{0.0};
+  uint64_t windows_checked{0};
+  int64_t  virtual_ms{0};
+};
+
+class Replay {
+private:
+  const Options&                              options_;
+  FpsVirtualClock                             clock_;
+  FpsMonitor&                                 monitor_;
+  std::vector<Channel>                        channels_;
+  std::unordered_map<FpsKey, size_t, KeyHash> index_;
+  int64_t                                     now_ms_{0};
+  int64_t                                     last_sample_ms_{0};
+  bool                                        do_check_window_{false};
+  Result                                      result_;
+
+  FpsMonitorConfig with_clock_(FpsMonitorConfig config) {
+    config.clock = &clock_;
+    return config;
+  }
+
+  void tick_(Channel& channel, uint64_t count) {
+    channel.handle.tick(count);
+    channel.ticks += count;
+  }
+
+  void check_(const Channel& channel, const char* what, double fps) {
+    const double error = std::fabs(fps - channel.expected);
+    result_.max_error  = std::max(result_.max_error, error);
+    if (error > options_.tolerance) {
+      if (result_.failures < MAX_REPORTED_FAILURES) {
+        fmt::print(stderr, "t={}ms {:04}.{:04}.{:04}: {} {:.3f}, expected {:.3f}\n", now_ms_, channel.key.app_id,
+                   channel.key.channel_id, channel.key.thread_id, what, fps, channel.expected);
+      }
+      result_.failures++;
+    }
+  }
+
+  // Every rate must equal the ticks fed over the pass divided by its length.
+  void step_(bool do_log) {
+    monitor_.step(do_log);
+    const double seconds = static_cast<double>(now_ms_ - last_sample_ms_) / MILLI_SECONDS_IN_SECOND;
+    last_sample_ms_      = now_ms_;
+    result_.passes++;
+    for (Channel& channel : channels_) {
+      if (!channel.is_present) {
+        continue;
+      }
+      const FpsKey& key = channel.key;
+      channel.expected  = static_cast<double>(channel.ticks) / seconds;
+      check_(channel, "fps", monitor_.fps(key.app_id, key.channel_id, key.thread_id).load());
+      // The first pass only gives the estimator its baseline.
+      if (do_check_window_ && result_.passes > 1) {
+        check_(channel, "window", monitor_.rate_stats(key.app_id, key.channel_id, key.thread_id).window);
+        result_.windows_checked++;
+      }
+      channel.ticks = 0;
+      result_.checked++;
+    }
+  }
+
+  void advance_(int64_t to_ms) {
+    clock_.advance_ns((to_ms - now_ms_) * NANO_SECONDS_IN_MILLI_SECOND);
+    now_ms_ = to_ms;
+  }
+
+  Channel& channel_(const FpsKey& key, bool& is_new) {
+    const auto inserted = index_.emplace(key, channels_.size());
+    is_new              = inserted.second;
+    if (!is_new) {
+      return channels_[inserted.first->second];
+    }
+    Channel& channel   = channels_.emplace_back();
+    channel.key        = key;
+    channel.handle     = monitor_.handle(key.app_id, key.channel_id, key.thread_id);
+    channel.is_present = true;
+    return channel;
+  }
+
+public:
+  Replay(const Options& options, int64_t epoch_ms, const FpsMonitorConfig& config)
+      : options_(options), clock_(epoch_ms),
+        monitor_(FpsMonitorGroup::getInstance().create(MONITOR_NAME, options.session_dir, MONITOR_NAME,
+                                                       with_clock_(config))) {}
+
+  void run_synthetic() {
+    channels_.reserve(options_.channels);
+    bool is_new = false;
+    for (uint64_t i = 0; i < options_.channels; i++) {
+      Channel& channel = channel_(FpsKey{1, i, 0}, is_new);
+      channel.fps      = options_.slow_every != 0 && i % options_.slow_every == 0 ? options_.slow_fps : options_.fps;
+      monitor_.estimate(channel.key.app_id, channel.key.channel_id, channel.key.thread_id);
+    }
+    // A shorter pass leaves several passes in the window, whose rate then no longer matches the last one alone.
+    const FpsEstimatorConfig estimator;
+    do_check_window_ = options_.sample_ms >= estimator.bucket.count() * static_cast<int64_t>(estimator.buckets);
+
+    int64_t next_sample = options_.sample_ms;
+    int64_t next_log    = options_.log_ms;
+    while (now_ms_ < options_.seconds * MILLI_SECONDS_IN_SECOND) {
+      advance_(now_ms_ + options_.tick_ms);
+      for (Channel& channel : channels_) {
+        channel.owed += channel.fps * static_cast<double>(options_.tick_ms) / MILLI_SECONDS_IN_SECOND;
+        const auto count = static_cast<uint64_t>(channel.owed);
+        channel.owed -= static_cast<double>(count);
+        tick_(channel, count);
+      }
+      if (now_ms_ >= next_sample) {
+        const bool do_log = now_ms_ >= next_log;
+        step_(do_log);
+        next_sample += options_.sample_ms;
+        if (do_log) {
+          next_log += options_.log_ms;
+        }
+      }
+    }
+  }
+
+  bool run_recording(const std::string& file, int64_t& base_ts) {
+    FpsRecordReader reader;
+    FpsSnapshot     snapshot;
+    if (!reader.open(file)) {
+      fmt::print(stderr, "cannot read recording {}\n", file);
+      return false;
+    }
+    while (reader.next(snapshot)) {
+      if (base_ts == INT64_MIN) {
+        base_ts = snapshot.ts;
+      }
+      // The first sight of a channel only sets its baseline.
+      for (Channel& channel : channels_) {
+        channel.is_present = false;
+      }
+      for (const FpsSample& sample : snapshot.samples) {
+        bool     is_new    = false;
+        Channel& channel   = channel_(sample.key, is_new);
+        channel.is_present = true;
+        if (!is_new && sample.value >= channel.total) {
+          tick_(channel, sample.value - channel.total);
+        }
+        channel.total = sample.value;
+      }
+      const int64_t to_ms = snapshot.ts - base_ts;
+      if (to_ms > now_ms_) {
+        advance_(to_ms);
+        step_(true);
+      }
+    }
+    return true;
+  }
+
+  Result finish() {
+    monitor_.shutdown();
+    result_.virtual_ms = now_ms_;
+    return result_;
+  }
+
+  // Channels the summary log should count as valid under the default health rule.
+  uint64_t expected_valid() const {
+    const FpsHealthRule rule;
+    return static_cast<uint64_t>(std::count_if(channels_.begin(), channels_.end(), [&](const Channel& channel) {
+      return channel.is_present && rule.min_fps <= channel.expected && channel.expected <= rule.max_fps;
+    }));
+  }
+};
+
+// Count on the last Valid line of the summary log, or -1 when there is none.
+int64_t last_valid_count(const std::string& path) {
+  std::ifstream file(path);
+  std::string   line;
+  int64_t       count = -1;
+  while (std::getline(file, line)) {
+    const size_t at = line.find(VALID_TAG);
+    if (at != std::string::npos) {
+      count = std::stoll(line.substr(at + std::char_traits<char>::length(VALID_TAG)));
+    }
+  }
+  return count;
+}
+} // namespace
+
+auto main(int argc, char const* argv[]) -> int {
+  const std::vector<std::string> args(argv, argv + argc);
+  Options                        options;
+  for (size_t i = 1; i < args.size(); i++) {
+    const bool has_value = i + 1 < args.size();
+    if (args[i] == "--channels" && has_value) {
+      options.channels = std::stoull(args[++i]);
+    } else if (args[i] == "--fps" && has_value) {
+      options.fps = std::stod(args[++i]);
+    } else if (args[i] == "--slow-every" && has_value) {
+      options.slow_every = std::stoull(args[++i]);
+    } else if (args[i] == "--slow-fps" && has_value) {
+      options.slow_fps = std::stod(args[++i]);
+    } else if (args[i] == "--seconds" && has_value) {
+      options.seconds = std::stoll(args[++i]);
+    } else if (args[i] == "--tick-ms" && has_value) {
+      options.tick_ms = std::max<int64_t>(1, std::stoll(args[++i]));
+    } else if (args[i] == "--sample-ms" && has_value) {
+      options.sample_ms = std::stoll(args[++i]);
+    } else if (args[i] == "--log-ms" && has_value) {
+      options.log_ms = std::stoll(args[++i]);
+    } else if (args[i] == "--log-epsilon" && has_value) {
+      options.log_epsilon = std::stof(args[++i]);
+    } else if (args[i] == "--tolerance" && has_value) {
+      options.tolerance = std::stod(args[++i]);
+    } else if (args[i] == "--session" && has_value) {
+      options.session_dir = args[++i];
+    } else if (args[i].rfind("--", 0) == 0) {
+      fmt::print(stderr,
+                 "usage: {} [--channels n] [--fps f] [--slow-every k] [--slow-fps f] [--seconds s] [--tick-ms ms] "
+                 "[--sample-ms ms] [--log-ms ms] [--log-epsilon f] [--tolerance f] [--session dir] [recording...]\n",
+                 args[0]);
+      return 2;
+    } else {
+      options.recordings.push_back(args[i]);
+    }
+  }
+
+  // The monitor clamps both intervals the same way, and the replay has to step exactly where it samples.
+  const auto min_interval = FpsMonitorConfig::MIN_INTERVAL.count();
+  options.sample_ms       = std::max<int64_t>(options.sample_ms, min_interval);
+  options.log_ms          = std::max<int64_t>(options.log_ms, min_interval);
+  FpsMonitorConfig config;
+  config.manual          = true;
+  config.sample_interval = std::chrono::milliseconds(options.sample_ms);
+  config.log_interval    = std::chrono::milliseconds(options.log_ms);
+  config.log_epsilon     = options.log_epsilon;
+
+  const int64_t epoch_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch())
+          .count();
+  const auto start = std::chrono::steady_clock::now();
+  Replay     replay(options, epoch_ms, config);
+  if (options.recordings.empty()) {
+    replay.run_synthetic();
+  } else {
+    int64_t base_ts = INT64_MIN;
+    for (const std::string& file : options.recordings) {
+      if (!replay.run_recording(file, base_ts)) {
+        return 1;
+      }
+    }
+  }
+  const uint64_t expected_valid = replay.expected_valid();
+  const Result   result         = replay.finish();
+  const double   wall_ms =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  const std::string summary_path = fmt::format("{}/{}_summary.log", options.session_dir, MONITOR_NAME);
+  const int64_t     valid        = last_valid_count(summary_path);
+  fmt::print("{{\"virtual_s\":{:.1f},\"wall_s\":{:.3f},\"speedup\":{:.0f},\"passes\":{},\"rates_checked\":{},"
+             "\"windows_checked\":{},\"rate_failures\":{},\"max_error\":{:.4f},\"valid\":{},\"expected_valid\":{}}}\n",
+             static_cast<double>(result.virtual_ms) / MILLI_SECONDS_IN_SECOND, wall_ms / MILLI_SECONDS_IN_SECOND,
+             wall_ms > 0 ? static_cast<double>(result.virtual_ms) / wall_ms : 0.0, result.passes, result.checked,
+             result.windows_checked, result.failures, result.max_error, valid, expected_valid);
+  if (result.failures != 0) {
+    return 1;
+  }
+  if (valid != static_cast<int64_t>(expected_valid)) {
+    fmt::print(stderr, "{}: last Valid count {}, expected {}\n", summary_path, valid, expected_valid);
+    return 1;
+  }
+  return 0;
+}
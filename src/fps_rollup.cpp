@@ -0,0 +1,223 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#include "fps_rollup.h"
+
+#include <algorithm>
+
+FpsRollup::FpsRollup() { nodes_.emplace_back(); }
+
+uint32_t FpsRollup::app_node_(uint64_t app_id) {
+  auto it = app_nodes_.find(app_id);
+  if (it != app_nodes_.end()) {
+    return it->second;
+  }
+  const auto index = static_cast<uint32_t>(nodes_.size());
+  nodes_.emplace_back().value.app_id = app_id;
+  app_nodes_.emplace(app_id, index);
+  return index;
+}
+
+uint32_t FpsRollup::channel_node_(uint64_t app_id, uint64_t channel_id) {
+  auto it = channel_nodes_.find({app_id, channel_id});
+  if (it != channel_nodes_.end()) {
+    return it->second;
+  }
+  const uint32_t parent = app_node_(app_id);
+  const auto     index  = static_cast<uint32_t>(nodes_.size());
+  Node&          node   = nodes_.emplace_back();
+  node.value.app_id     = app_id;
+  node.value.channel_id = channel_id;
+  nodes_[parent].children.push_back(index);
+  channel_nodes_.emplace(std::make_pair(app_id, channel_id), index);
+  return index;
+}
+
+void FpsRollup::add_(size_t index, bool is_added) {
+  const Leaf&  leaf = leaves_[index];
+  const double fps  = fps_[index];
+  for (const uint32_t node_index : {TOTAL_NODE, leaf.app_node, leaf.channel_node}) {
+    Node&     node   = nodes_[node_index];
+    uint32_t& health = node.value.health[static_cast<size_t>(leaf.health)];
+    if (is_added) {
+      node.value.channels++;
+      health++;
+      node.fps += fps;
+    } else {
+      node.value.channels--;
+      health--;
+      node.fps = node.value.channels != 0 ? std::max(node.fps - fps, 0.0) : 0.0;
+    }
+    node.value.fps = static_cast<float>(node.fps);
+  }
+}
+
+void FpsRollup::set_fps_(size_t index, float fps) {
+  const Leaf&  leaf  = leaves_[index];
+  const double delta = static_cast<double>(fps) - static_cast<double>(fps_[index]);
+  for (const uint32_t node_index : {TOTAL_NODE, leaf.app_node, leaf.channel_node}) {
+    Node& node     = nodes_[node_index];
+    node.fps       = std::max(node.fps + delta, 0.0);
+    node.value.fps = static_cast<float>(node.fps);
+  }
+  fps_[index] = fps;
+}
+
+void FpsRollup::refresh_(size_t index, float fps) {
+  if (fps == fps_[index]) {
+    return;
+  }
+  if (leaves_[index].is_tracked) {
+    set_fps_(index, fps);
+  } else {
+    fps_[index] = fps;
+  }
+}
+
+void FpsRollup::set_health_(Leaf& leaf, FpsHealthState state) {
+  for (const uint32_t index : {TOTAL_NODE, leaf.app_node, leaf.channel_node}) {
+    Node& node = nodes_[index];
+    node.value.health[static_cast<size_t>(leaf.health)]--;
+    node.value.health[static_cast<size_t>(state)]++;
+  }
+  leaf.health = state;
+}
+
+void FpsRollup::track_(const FpsRegistry& registry, const FpsHealth& health, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    const FpsStatus& status     = registry.at(i);
+    Leaf&            leaf       = leaves_[i];
+    const bool       is_live    = status.is_live();
+    const uint32_t   generation = status.generation.load(std::memory_order_acquire);
+    if (leaf.is_tracked && (!is_live || leaf.generation != generation)) {
+      add_(i, false);
+      leaf = Leaf{};
+    }
+    if (!is_live || leaf.is_tracked) {
+      continue;
+    }
+    leaf.is_tracked   = true;
+    leaf.generation   = generation;
+    leaf.key          = status.key();
+    leaf.app_node     = app_node_(leaf.key.app_id);
+    leaf.channel_node = channel_node_(leaf.key.app_id, leaf.key.channel_id);
+    leaf.health       = health.state(status);
+    fps_[i]           = registry.fps_at(i);
+    add_(i, true);
+  }
+}
+
+void FpsRollup::update(const FpsRegistry& registry, const FpsHealth& health) {
+  const std::lock_guard<std::mutex> lock(mtx_);
+  // The version is read before the size: a registration that lands in between moves it again for the next pass.
+  const uint64_t layout = registry.layout_version();
+  const size_t   count  = registry.size();
+  if (leaves_.size() < count) {
+    leaves_.resize(count);
+    fps_.resize(count);
+  }
+  if (layout != layout_version_) {
+    layout_version_ = layout;
+    track_(registry, health, count);
+    for (size_t base = 0; base < count; base += FPS_SEGMENT_SIZE) {
+      const std::atomic<float>* rates = registry.fps_block(base);
+      const size_t              n     = std::min(FPS_SEGMENT_SIZE, count - base);
+      for (size_t j = 0; j < n; j++) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        refresh_(base + j, rates[j].load(std::memory_order_relaxed));
+      }
+    }
+    return;
+  }
+  // Same layout: only the cells whose rate the sampling pass just moved can differ from what they contributed.
+  for (const uint32_t i : registry.changed()) {
+    if (i < count) {
+      refresh_(i, registry.fps_at(i));
+    }
+  }
+}
+
+void FpsRollup::apply(const FpsRegistry& registry, const std::vector<FpsHealthEvent>& transitions) {
+  if (transitions.empty()) {
+    return;
+  }
+  const std::lock_guard<std::mutex> lock(mtx_);
+  for (const FpsHealthEvent& event : transitions) {
+    const FpsStatus* status = registry.find(event.key);
+    if (status == nullptr || status->index >= leaves_.size()) {
+      continue;
+    }
+    Leaf& leaf = leaves_[status->index];
+    if (leaf.is_tracked && leaf.key == event.key && leaf.health != event.to) {
+      set_health_(leaf, event.to);
+    }
+  }
+}
+
+FpsRollupNode FpsRollup::total() const {
+  const std::lock_guard<std::mutex> lock(mtx_);
+  return nodes_[TOTAL_NODE].value;
+}
+
+FpsRollupNode FpsRollup::app(uint64_t app_id) const {
+  const std::lock_guard<std::mutex> lock(mtx_);
+  auto                              it = app_nodes_.find(app_id);
+  if (it == app_nodes_.end()) {
+    FpsRollupNode node;
+    node.app_id = app_id;
+    return node;
+  }
+  return nodes_[it->second].value;
+}
+
+FpsRollupNode FpsRollup::channel(uint64_t app_id, uint64_t channel_id) const {
+  const std::lock_guard<std::mutex> lock(mtx_);
+  auto                              it = channel_nodes_.find({app_id, channel_id});
+  if (it == channel_nodes_.end()) {
+    FpsRollupNode node;
+    node.app_id     = app_id;
+    node.channel_id = channel_id;
+    return node;
+  }
+  return nodes_[it->second].value;
+}
+
+std::vector<FpsRollupNode> FpsRollup::apps() const {
+  std::vector<FpsRollupNode> apps;
+  this->apps(apps);
+  return apps;
+}
+
+std::vector<FpsRollupNode> FpsRollup::channels(uint64_t app_id) const {
+  std::vector<FpsRollupNode> channels;
+  this->channels(app_id, channels);
+  return channels;
+}
+
+void FpsRollup::apps(std::vector<FpsRollupNode>& out) const {
+  const std::lock_guard<std::mutex> lock(mtx_);
+  out.clear();
+  for (const auto& entry : app_nodes_) {
+    const FpsRollupNode& node = nodes_[entry.second].value;
+    if (node.channels != 0) {
+      out.push_back(node);
+    }
+  }
+}
+
+void FpsRollup::channels(uint64_t app_id, std::vector<FpsRollupNode>& out) const {
+  const std::lock_guard<std::mutex> lock(mtx_);
+  auto                              it = app_nodes_.find(app_id);
+  out.clear();
+  if (it == app_nodes_.end()) {
+    return;
+  }
+  for (const uint32_t index : nodes_[it->second].children) {
+    if (nodes_[index].value.channels != 0) {
+      out.push_back(nodes_[index].value);
+    }
+  }
+  std::sort(out.begin(), out.end(),
+            [](const FpsRollupNode& a, const FpsRollupNode& b) { return a.channel_id < b.channel_id; });
+}
@@ -0,0 +1,245 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#include "fps_shm.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr size_t FPS_SHM_ALIGNMENT = 64;
+constexpr size_t header_size() {
+  return (sizeof(FpsShmHeader) + FPS_SHM_ALIGNMENT - 1) / FPS_SHM_ALIGNMENT * FPS_SHM_ALIGNMENT;
+}
+
+#if !defined(_WIN32)
+std::string posix_name(const std::string& name) { return name.empty() || name[0] != '/' ? "/" + name : name; }
+#endif
+
+uint32_t float_bits(float value) {
+  uint32_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+float bits_float(uint32_t bits) {
+  float value = 0;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+uint64_t current_pid() {
+#if defined(_WIN32)
+  return GetCurrentProcessId();
+#else
+  return static_cast<uint64_t>(getpid());
+#endif
+}
+} // namespace
+
+FpsShmEntry* FpsShmSegment::entries_() const {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  return reinterpret_cast<FpsShmEntry*>(static_cast<char*>(data_) + header_()->header_size);
+}
+
+void FpsShmSegment::unmap_() {
+  if (data_ == nullptr) {
+    return;
+  }
+#if defined(_WIN32)
+  UnmapViewOfFile(data_);
+  CloseHandle(reinterpret_cast<HANDLE>(handle_)); // NOLINT(performance-no-int-to-ptr)
+#else
+  munmap(data_, size_);
+#endif
+  data_   = nullptr;
+  size_   = 0;
+  handle_ = -1;
+}
+
+bool FpsShmWriter::open(const std::string& name, size_t capacity) {
+  close();
+  const size_t size = header_size() + capacity * sizeof(FpsShmEntry);
+#if defined(_WIN32)
+  HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                      static_cast<DWORD>(static_cast<uint64_t>(size) >> 32U),
+                                      static_cast<DWORD>(size & 0xffffffffU), name.c_str());
+  if (mapping == nullptr) {
+    return false;
+  }
+  void* data = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+  if (data == nullptr) {
+    CloseHandle(mapping);
+    return false;
+  }
+  handle_ = reinterpret_cast<std::intptr_t>(mapping);
+#else
+  // Readers still attached to a previous segment keep their mapping; new readers find this one.
+  const std::string shm_name = posix_name(name);
+  shm_unlink(shm_name.c_str());
+  const int fd = shm_open(shm_name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+  if (fd < 0) {
+    return false;
+  }
+  if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+    ::close(fd);
+    shm_unlink(shm_name.c_str());
+    return false;
+  }
+  void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) { // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+    shm_unlink(shm_name.c_str());
+    return false;
+  }
+#endif
+  name_ = name;
+  data_ = data;
+  size_ = size;
+
+  FpsShmHeader* header = header_();
+  header->version      = FPS_SHM_VERSION;
+  header->header_size  = static_cast<uint32_t>(header_size());
+  header->entry_size   = sizeof(FpsShmEntry);
+  header->capacity     = capacity;
+  header->pid          = current_pid();
+  header->magic.store(FPS_SHM_MAGIC, std::memory_order_release);
+  return true;
+}
+
+void FpsShmWriter::publish(const FpsSnapshot& snapshot) {
+  if (data_ == nullptr) {
+    return;
+  }
+  FpsShmHeader*  header   = header_();
+  FpsShmEntry*   entries  = entries_();
+  const size_t   count    = std::min<size_t>(snapshot.samples.size(), header->capacity);
+  const uint64_t sequence = header->sequence.load(std::memory_order_relaxed);
+
+  header->sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t i = 0; i < count; i++) {
+    const FpsSample& sample = snapshot.samples[i];
+    FpsShmEntry&     entry  = entries[i]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    entry.app_id.store(sample.key.app_id, std::memory_order_relaxed);
+    entry.channel_id.store(sample.key.channel_id, std::memory_order_relaxed);
+    entry.thread_id.store(sample.key.thread_id, std::memory_order_relaxed);
+    entry.value.store(sample.value, std::memory_order_relaxed);
+    entry.fps_bits.store(float_bits(sample.fps), std::memory_order_relaxed);
+    entry.dump_in_log.store(sample.dump_in_log ? 1 : 0, std::memory_order_relaxed);
+  }
+  header->ts.store(snapshot.ts, std::memory_order_relaxed);
+  header->count.store(count, std::memory_order_relaxed);
+  header->channels.store(snapshot.samples.size(), std::memory_order_relaxed);
+  header->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void FpsShmWriter::close() {
+  if (data_ == nullptr) {
+    return;
+  }
+  unmap_();
+#if !defined(_WIN32)
+  shm_unlink(posix_name(name_).c_str());
+#endif
+  name_.clear();
+}
+
+bool FpsShmReader::attach(const std::string& name) {
+  detach();
+#if defined(_WIN32)
+  HANDLE mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, name.c_str());
+  if (mapping == nullptr) {
+    return false;
+  }
+  void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (data == nullptr) {
+    CloseHandle(mapping);
+    return false;
+  }
+  MEMORY_BASIC_INFORMATION info{};
+  VirtualQuery(data, &info, sizeof(info));
+  const size_t size = info.RegionSize;
+  handle_           = reinterpret_cast<std::intptr_t>(mapping);
+#else
+  const int fd = shm_open(posix_name(name).c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat info {};
+  if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < header_size()) {
+    ::close(fd);
+    return false;
+  }
+  const auto size = static_cast<size_t>(info.st_size);
+  void*      data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) { // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+    return false;
+  }
+#endif
+  name_ = name;
+  data_ = data;
+  size_ = size;
+
+  const FpsShmHeader* header = header_();
+  if (header->magic.load(std::memory_order_acquire) != FPS_SHM_MAGIC || header->version != FPS_SHM_VERSION ||
+      header->entry_size != sizeof(FpsShmEntry) ||
+      header->header_size + header->capacity * header->entry_size > size_) {
+    detach();
+    return false;
+  }
+  return true;
+}
+
+void FpsShmReader::detach() {
+  unmap_();
+  name_.clear();
+}
+
+bool FpsShmReader::read(FpsSnapshot& snapshot, uint64_t* channels, int max_retries) const {
+  if (data_ == nullptr) {
+    return false;
+  }
+  const FpsShmHeader* header  = header_();
+  const FpsShmEntry*  entries = entries_();
+  for (int attempt = 0; attempt < max_retries; attempt++) {
+    const uint64_t before = header->sequence.load(std::memory_order_acquire);
+    if ((before & 1U) != 0) {
+      std::this_thread::yield();
+      continue;
+    }
+    const size_t count = std::min<uint64_t>(header->count.load(std::memory_order_relaxed), header->capacity);
+    snapshot.ts        = header->ts.load(std::memory_order_relaxed);
+    snapshot.samples.resize(count);
+    for (size_t i = 0; i < count; i++) {
+      const FpsShmEntry& entry  = entries[i]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      FpsSample&         sample = snapshot.samples[i];
+      sample.key.app_id         = entry.app_id.load(std::memory_order_relaxed);
+      sample.key.channel_id     = entry.channel_id.load(std::memory_order_relaxed);
+      sample.key.thread_id      = entry.thread_id.load(std::memory_order_relaxed);
+      sample.value              = entry.value.load(std::memory_order_relaxed);
+      sample.fps                = bits_float(entry.fps_bits.load(std::memory_order_relaxed));
+      sample.dump_in_log        = entry.dump_in_log.load(std::memory_order_relaxed) != 0;
+    }
+    const uint64_t total = header->channels.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (header->sequence.load(std::memory_order_relaxed) == before) {
+      if (channels != nullptr) {
+        *channels = total;
+      }
+      return true;
+    }
+  }
+  return false;
+}
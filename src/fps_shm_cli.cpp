@@ -0,0 +1,68 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#include "fps_shm.h"
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fmt/core.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Attaches to a monitor's shared-memory segment and prints it.
+// Usage: fpsshm <segment> [watch_ms]. With watch_ms the segment is printed again whenever a new pass is published.
+
+namespace {
+bool parse_interval(const std::string& text, int64_t& interval_ms) {
+  const char* end    = text.data() + text.size(); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  const auto  result = std::from_chars(text.data(), end, interval_ms);
+  return result.ec == std::errc() && result.ptr == end && interval_ms >= 0;
+}
+
+void print(const FpsSnapshot& snapshot, uint64_t channels, uint64_t pid) {
+  fmt::print("pid {} ts {} channels {} published {}\n", pid, snapshot.ts, channels, snapshot.samples.size());
+  fmt::print("App .Chn .Thr        Fps        Count\n");
+  for (auto&& sample : snapshot.samples) {
+    fmt::print("{:04}.{:04}.{:04} {:>9.1f} {:>12}\n", sample.key.app_id, sample.key.channel_id, sample.key.thread_id,
+               sample.fps, sample.value);
+  }
+  std::fflush(stdout);
+}
+} // namespace
+
+auto main(int argc, char const* argv[]) -> int {
+  const std::vector<std::string> args(argv, argv + argc);
+  int64_t                        watch_ms = 0;
+  if (args.size() < 2 || (args.size() > 2 && !parse_interval(args[2], watch_ms))) {
+    fmt::print(stderr, "usage: {} <segment> [watch_ms]\n", args[0]);
+    return 2;
+  }
+
+  FpsShmReader reader;
+  if (!reader.attach(args[1])) {
+    fmt::print(stderr, "cannot attach to segment {}\n", args[1]);
+    return 1;
+  }
+
+  FpsSnapshot snapshot;
+  uint64_t    channels      = 0;
+  uint64_t    last_sequence = UINT64_MAX;
+  do {
+    const uint64_t sequence = reader.sequence();
+    if (sequence != last_sequence) {
+      if (!reader.read(snapshot, &channels)) {
+        fmt::print(stderr, "segment {} is being rewritten too often to read\n", args[1]);
+        return 1;
+      }
+      last_sequence = sequence;
+      print(snapshot, channels, reader.pid());
+    }
+    if (watch_ms > 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(watch_ms));
+    }
+  } while (watch_ms > 0);
+  return 0;
+}
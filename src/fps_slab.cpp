@@ -0,0 +1,231 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#include "fps_slab.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+constexpr float MILLI_SECONDS_IN_SECONDS = 1000.0F;
+
+constexpr uint64_t mix(uint64_t x) {
+  // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+  x ^= x >> 30U;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27U;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31U;
+  // NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+  return x;
+}
+
+std::atomic_size_t next_stripe_index{0};
+size_t             this_thread_stripe_index() {
+  thread_local const size_t index = next_stripe_index.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+} // namespace
+
+uint64_t FpsKey::hash() const { return mix(app_id ^ mix(channel_id ^ mix(thread_id))); }
+
+FpsStripeSet::FpsStripeSet(size_t count)
+    : mask(count - 1), lines(std::make_unique<FpsStripe[]>(count)) {} // NOLINT(cppcoreguidelines-avoid-c-arrays)
+
+std::atomic_uint_fast64_t& FpsStatus::counter() {
+  FpsStripeSet* set = stripes.load(std::memory_order_acquire);
+  if (set == nullptr) {
+    return value;
+  }
+  return set->lines[this_thread_stripe_index() & set->mask].value;
+}
+
+uint64_t FpsStatus::total() const {
+  uint64_t      sum = value.load(std::memory_order_relaxed);
+  FpsStripeSet* set = stripes.load(std::memory_order_acquire);
+  if (set != nullptr) {
+    for (size_t i = 0; i <= set->mask; i++) {
+      sum += set->lines[i].value.load(std::memory_order_relaxed);
+    }
+  }
+  return sum;
+}
+
+bool FpsStatus::enable_striping(size_t stripe_count) {
+  size_t count = 1;
+  while (count < stripe_count && count < FPS_MAX_STRIPES) {
+    count <<= 1U;
+  }
+  if (count < 2) {
+    return false;
+  }
+  auto          set      = std::make_unique<FpsStripeSet>(count);
+  FpsStripeSet* expected = nullptr;
+  if (!stripes.compare_exchange_strong(expected, set.get(), std::memory_order_acq_rel)) {
+    return false;
+  }
+  stripe_storage = std::move(set);
+  return true;
+}
+
+bool FpsStatus::enable_estimator(const FpsEstimatorConfig& config) {
+  auto              created  = std::make_unique<FpsRateEstimator>(config);
+  FpsRateEstimator* expected = nullptr;
+  if (!estimator.compare_exchange_strong(expected, created.get(), std::memory_order_acq_rel)) {
+    return false;
+  }
+  estimator_storage = std::move(created);
+  return true;
+}
+
+bool FpsStatus::enable_timing() {
+  auto       created  = std::make_unique<FpsJitter>();
+  FpsJitter* expected = nullptr;
+  if (!jitter.compare_exchange_strong(expected, created.get(), std::memory_order_acq_rel)) {
+    return false;
+  }
+  jitter_storage = std::move(created);
+  return true;
+}
+
+void FpsSlab::allocate_(size_t segment) {
+  if (segment >= MAX_SEGMENTS) {
+    throw std::length_error("FpsSlab capacity exceeded");
+  }
+  if (segments_[segment].load(std::memory_order_relaxed) == nullptr) {
+    storage_.emplace_back(std::make_unique<FpsSegment>());
+    segments_[segment].store(storage_.back().get(), std::memory_order_release);
+  }
+}
+
+void FpsSlab::reserve(size_t count) {
+  const std::lock_guard<std::mutex> lock(append_mtx_);
+  const size_t                      reusable = free_.size();
+  if (count <= reusable) {
+    return;
+  }
+  const size_t end = size_.load(std::memory_order_relaxed) + count - reusable;
+  for (size_t segment = 0; segment * FPS_SEGMENT_SIZE < end; segment++) {
+    allocate_(segment);
+  }
+}
+
+FpsStatus& FpsSlab::append(const FpsKey& key, bool dump_in_log) {
+  const std::lock_guard<std::mutex> lock(append_mtx_);
+  size_t                            index = size_.load(std::memory_order_relaxed);
+  const bool                        reuse = !free_.empty();
+  if (reuse) {
+    index = free_.back();
+    free_.pop_back();
+  } else {
+    allocate_(index / FPS_SEGMENT_SIZE);
+  }
+
+  FpsSegment&  segment = segment_(index);
+  const size_t offset  = index % FPS_SEGMENT_SIZE;
+  FpsStatus&   status  = segment.status[offset];
+  status.app_id.store(key.app_id, std::memory_order_relaxed);
+  status.channel_id.store(key.channel_id, std::memory_order_relaxed);
+  status.thread_id.store(key.thread_id, std::memory_order_relaxed);
+  status.dump_in_log.store(dump_in_log, std::memory_order_relaxed);
+  status.index = static_cast<uint32_t>(index);
+  live_.fetch_add(1, std::memory_order_relaxed);
+  if (reuse) {
+    // reclaim_() already cleared the cell on the monitor thread.
+    status.generation.fetch_add(1, std::memory_order_release);
+  } else {
+    size_.store(index + 1, std::memory_order_release);
+  }
+  // Last, so whoever sees the new version also sees the cell it describes.
+  layout_version_.fetch_add(1, std::memory_order_release);
+  return status;
+}
+
+void FpsSlab::retire(FpsStatus& status) {
+  const std::lock_guard<std::mutex> lock(append_mtx_);
+  if (!status.is_live()) {
+    return;
+  }
+  status.generation.fetch_add(1, std::memory_order_release);
+  live_.fetch_sub(1, std::memory_order_relaxed);
+  layout_version_.fetch_add(1, std::memory_order_release);
+  retired_.push_back(Retired{status.index, pass_.load(std::memory_order_relaxed)});
+  retired_count_.store(retired_.size(), std::memory_order_relaxed);
+}
+
+void FpsSlab::clear_(size_t index) {
+  FpsSegment&  segment = segment_(index);
+  const size_t offset  = index % FPS_SEGMENT_SIZE;
+  FpsStatus&   status  = segment.status[offset];
+  // The grace period has passed, so nothing that checks generations still ticks the previous owner's counters. Stripes
+  // are zeroed rather than freed so stale raw references stay memory safe.
+  if (FpsStripeSet* set = status.stripes.load(std::memory_order_relaxed)) {
+    for (size_t i = 0; i <= set->mask; i++) {
+      set->lines[i].value.store(0, std::memory_order_relaxed);
+    }
+  }
+  if (FpsJitter* timing = status.jitter.load(std::memory_order_relaxed)) {
+    timing->clear();
+  }
+  status.value.store(0, std::memory_order_relaxed);
+  segment.sample[offset]      = 0;
+  segment.last_value[offset]  = 0;
+  segment.rate[offset]        = 0;
+  segment.last_change[offset] = 0;
+  segment.last_fps[offset].store(0, std::memory_order_relaxed);
+}
+
+void FpsSlab::reclaim_() {
+  const std::lock_guard<std::mutex> lock(append_mtx_);
+  const uint64_t                    pass = pass_.fetch_add(1, std::memory_order_relaxed) + 1;
+  auto                              itr  = retired_.begin();
+  while (itr != retired_.end() && pass - itr->pass >= FPS_RECLAIM_PASSES) {
+    clear_(itr->index);
+    free_.push_back(itr->index);
+    ++itr;
+  }
+  retired_.erase(retired_.begin(), itr);
+  retired_count_.store(retired_.size(), std::memory_order_relaxed);
+}
+
+void FpsSlab::compute_rates(int64_t time_diff_ms, int64_t now_ms) {
+  const float  scale = MILLI_SECONDS_IN_SECONDS / static_cast<float>(time_diff_ms);
+  const size_t count = size();
+  changed_.clear();
+  for (size_t base = 0; base < count; base += FPS_SEGMENT_SIZE) {
+    FpsSegment&  segment = segment_(base);
+    const size_t n       = std::min(FPS_SEGMENT_SIZE, count - base);
+
+    for (size_t i = 0; i < n; i++) {
+      segment.sample[i] = segment.status[i].total();
+    }
+    // Plain arrays only, so the compiler is free to vectorise the delta and rate computation.
+    uint64_t*       last_value  = segment.last_value.data();
+    int64_t*        last_change = segment.last_change.data();
+    const uint64_t* sample      = segment.sample.data();
+    float*          rate        = segment.rate.data();
+    for (size_t i = 0; i < n; i++) {
+      rate[i]        = static_cast<float>(sample[i] - last_value[i]) * scale;                      // NOLINT
+      last_change[i] = (sample[i] != last_value[i] || last_change[i] == 0) ? now_ms : last_change[i]; // NOLINT
+      last_value[i]  = sample[i];                                                                  // NOLINT
+    }
+    for (size_t i = 0; i < n; i++) {
+      if (segment.last_fps[i].load(std::memory_order_relaxed) != rate[i]) { // NOLINT
+        segment.last_fps[i].store(rate[i], std::memory_order_relaxed);    // NOLINT
+        changed_.push_back(static_cast<uint32_t>(base + i));
+      }
+      FpsStatus& status = segment.status[i];
+      if (FpsRateEstimator* estimator = status.estimator.load(std::memory_order_acquire)) {
+        estimator->observe(now_ms, sample[i], status.generation.load(std::memory_order_relaxed)); // NOLINT
+      }
+    }
+  }
+
+  if (retired_count_.load(std::memory_order_relaxed) != 0) {
+    reclaim_();
+  } else {
+    pass_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
@@ -0,0 +1,58 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#include "fps_stats.h"
+
+#include <algorithm>
+
+namespace {
+size_t bucket_of(uint64_t ns) {
+  size_t bucket = 0;
+  while (ns != 0 && bucket + 1 < FPS_HISTOGRAM_BUCKETS) {
+    ns >>= 1U;
+    bucket++;
+  }
+  return bucket;
+}
+} // namespace
+
+uint64_t FpsHistogramSnapshot::quantile_ns(double q) const {
+  if (count == 0) {
+    return 0;
+  }
+  const auto rank = static_cast<uint64_t>(q * static_cast<double>(count));
+  uint64_t   seen = 0;
+  for (size_t i = 0; i < FPS_HISTOGRAM_BUCKETS; i++) {
+    seen += buckets[i];
+    if (seen > rank) {
+      return std::min(i == 0 ? 0 : (uint64_t{1} << i) - 1, max_ns);
+    }
+  }
+  return max_ns;
+}
+
+void FpsHistogram::record(uint64_t ns) {
+  buckets_[bucket_of(ns)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  total_ns_.fetch_add(ns, std::memory_order_relaxed);
+  uint64_t max = max_ns_.load(std::memory_order_relaxed);
+  while (ns > max && !max_ns_.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+  }
+}
+
+void FpsHistogram::record(std::chrono::steady_clock::duration duration) {
+  const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+  record(static_cast<uint64_t>(std::max<int64_t>(ns, 0)));
+}
+
+FpsHistogramSnapshot FpsHistogram::snapshot() const {
+  FpsHistogramSnapshot snapshot;
+  for (size_t i = 0; i < FPS_HISTOGRAM_BUCKETS; i++) {
+    snapshot.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+  }
+  snapshot.count    = count_.load(std::memory_order_relaxed);
+  snapshot.total_ns = total_ns_.load(std::memory_order_relaxed);
+  snapshot.max_ns   = max_ns_.load(std::memory_order_relaxed);
+  return snapshot;
+}
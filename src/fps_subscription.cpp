@@ -0,0 +1,154 @@
+// *****************************************************
+//    Copyright 2026 Videonetics Technology Pvt Ltd
+// *****************************************************
+
+#include "fps_subscription.h"
+
+#include <cstdint>
+#include <utility>
+
+FpsSnapshotRing::FpsSnapshotRing(size_t capacity) {
+  size_t size = 2;
+  while (size < capacity) {
+    size <<= 1U;
+  }
+  mask_  = size - 1;
+  cells_ = std::make_unique<Cell[]>(size); // NOLINT(cppcoreguidelines-avoid-c-arrays)
+  for (size_t i = 0; i < size; i++) {
+    cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+bool FpsSnapshotRing::push(FpsSnapshotPtr snapshot) {
+  size_t position = tail_.load(std::memory_order_relaxed);
+  for (;;) {
+    Cell&          cell     = cells_[position & mask_];
+    const size_t   sequence = cell.sequence.load(std::memory_order_acquire);
+    const intptr_t diff     = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+    if (diff == 0) {
+      if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        cell.snapshot = std::move(snapshot);
+        cell.sequence.store(position + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      return false; // full
+    } else {
+      position = tail_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+FpsSnapshotPtr FpsSnapshotRing::pop() {
+  size_t position = head_.load(std::memory_order_relaxed);
+  for (;;) {
+    Cell&          cell     = cells_[position & mask_];
+    const size_t   sequence = cell.sequence.load(std::memory_order_acquire);
+    const intptr_t diff     = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+    if (diff == 0) {
+      if (head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        FpsSnapshotPtr snapshot = std::move(cell.snapshot);
+        cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+        return snapshot;
+      }
+    } else if (diff < 0) {
+      return nullptr; // empty
+    } else {
+      position = head_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+FpsSubscription::FpsSubscription(const FpsSubscriptionConfig& config) : config_(config), ring_(config.capacity) {}
+
+void FpsSubscription::notify_(const std::atomic_int& waiting) {
+  // Pairs with the fence in the waiter: either it sees our push or pop, or we see it waiting.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (waiting.load(std::memory_order_relaxed) > 0) {
+    {
+      const std::lock_guard<std::mutex> lock(mtx_);
+    }
+    cv_.notify_all();
+  }
+}
+
+bool FpsSubscription::publish(const FpsSnapshotPtr& snapshot) {
+  if (is_closed()) {
+    return false;
+  }
+  bool is_pushed = ring_.push(snapshot);
+  if (!is_pushed) {
+    switch (config_.backpressure) {
+    case FpsBackpressure::DROP_OLDEST:
+      while (!is_pushed) {
+        if (ring_.pop()) {
+          dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+        is_pushed = ring_.push(snapshot);
+      }
+      break;
+    case FpsBackpressure::DROP_NEWEST:
+      break;
+    case FpsBackpressure::BLOCK: {
+      waiting_producers_.fetch_add(1);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      std::unique_lock<std::mutex> lock(mtx_);
+      const auto                   ready = [&] {
+        is_pushed = ring_.push(snapshot);
+        return is_pushed || is_closed();
+      };
+      if (config_.block_timeout.count() > 0) {
+        cv_.wait_for(lock, config_.block_timeout, ready);
+      } else {
+        cv_.wait(lock, ready);
+      }
+      waiting_producers_.fetch_sub(1);
+      break;
+    }
+    }
+  }
+  if (!is_pushed) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  delivered_.fetch_add(1, std::memory_order_relaxed);
+  notify_(waiting_consumers_);
+  return true;
+}
+
+FpsSnapshotPtr FpsSubscription::poll() {
+  FpsSnapshotPtr snapshot = ring_.pop();
+  if (snapshot && config_.backpressure == FpsBackpressure::BLOCK) {
+    notify_(waiting_producers_);
+  }
+  return snapshot;
+}
+
+FpsSnapshotPtr FpsSubscription::wait(std::chrono::milliseconds timeout) {
+  FpsSnapshotPtr snapshot = poll();
+  if (snapshot || is_closed()) {
+    return snapshot;
+  }
+  waiting_consumers_.fetch_add(1);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  {
+    std::unique_lock<std::mutex> lock(mtx_);
+    cv_.wait_for(lock, timeout, [&] {
+      snapshot = ring_.pop();
+      return snapshot || is_closed();
+    });
+  }
+  waiting_consumers_.fetch_sub(1);
+  if (snapshot && config_.backpressure == FpsBackpressure::BLOCK) {
+    notify_(waiting_producers_);
+  }
+  return snapshot;
+}
+
+void FpsSubscription::close() {
+  is_closed_.store(true, std::memory_order_release);
+  {
+    const std::lock_guard<std::mutex> lock(mtx_);
+  }
+  cv_.notify_all();
+}